@@ -1,10 +1,14 @@
 // Copyright (c) 2026, Team SDB. All rights reserved.
 
 #include "IVSmoke.h"
+#include "IVSmokeHoleAtlas.h"
+#include "IVSmokeRenderer.h"
 #include "IVSmokeSceneViewExtension.h"
+#include "IVSmokeVoxelAtlas.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/Paths.h"
+#include "RenderingThread.h"
 #include "Stats/Stats.h"
 
 DEFINE_LOG_CATEGORY(LogIVSmoke);
@@ -34,6 +38,14 @@ void FIVSmokeModule::ShutdownModule()
 {
 #if !UE_SERVER
 	FIVSmokeSceneViewExtension::Shutdown();
+
+	// The renderer singleton is only destroyed during static destruction, after the engine delegates are gone.
+	// Release its world delegates and render resources here, once in-flight render commands are done with them.
+	FlushRenderingCommands();
+	FIVSmokeRenderer::Get().Shutdown();
+
+	FIVSmokeHoleAtlas::Get().Release();
+	FIVSmokeVoxelAtlas::Get().Release();
 #endif
 }
 
@@ -51,6 +51,9 @@ void FIVSmokeCSMRenderer::Initialize(UWorld* World, int32 NumCascades, int32 Res
 		bEnablePriorityUpdate = Settings->bEnablePriorityUpdate;
 		NearCascadeUpdateInterval = Settings->NearCascadeUpdateInterval;
 		FarCascadeUpdateInterval = Settings->FarCascadeUpdateInterval;
+		CoveragePadding = Settings->CascadeCoveragePadding;
+		bFitToSmoke = Settings->bFitCascadesToSmoke;
+		CascadeBlendRange = Settings->CascadeBlendRange;
 	}
 
 	// Create owner actor for capture components
@@ -137,7 +140,8 @@ void FIVSmokeCSMRenderer::Update(
 	const FVector& CameraPosition,
 	const FVector& CameraForward,
 	const FVector& LightDirection,
-	uint32 FrameNumber)
+	uint32 FrameNumber,
+	TConstArrayView<FBox> SmokeBounds)
 {
 	if (!bIsInitialized || Cascades.Num() == 0)
 	{
@@ -176,7 +180,7 @@ void FIVSmokeCSMRenderer::Update(
 	}
 
 	// Determine which cascades need update
-	UpdateCascadePriorities(FrameNumber);
+	UpdateCascadePriorities(FrameNumber, CameraPosition, LightDirection, SmokeBounds);
 
 	// Update each cascade that needs it
 	for (int32 i = 0; i < Cascades.Num(); i++)
@@ -189,19 +193,145 @@ void FIVSmokeCSMRenderer::Update(
 	}
 }
 
-void FIVSmokeCSMRenderer::UpdateCascadePriorities(uint32 FrameNumber)
+void FIVSmokeCSMRenderer::UpdateCascadePriorities(uint32 FrameNumber, const FVector& CameraPosition, const FVector& LightDirection, TConstArrayView<FBox> SmokeBounds)
 {
-	// TODO: Priority update system disabled due to texel snapping synchronization issues.
-	// When a cascade is not updated, its texel-snapped position becomes stale relative to
-	// the current camera position, causing shadow flickering.
-	// Re-implement with proper synchronization: either update VP matrix every frame
-	// (even when not capturing), or use per-cascade camera positions for cascade selection.
-	for (FIVSmokeCascadeData& Cascade : Cascades)
+	const int32 NumCascades = Cascades.Num();
+	const FVector NormalizedLightDir = LightDirection.GetSafeNormal();
+
+	FVector LightRight, LightUp;
+	ComputeLightBasis(NormalizedLightDir, LightRight, LightUp);
+
+	for (int32 i = 0; i < NumCascades; i++)
 	{
-		Cascade.bNeedsCapture = true;
+		FIVSmokeCascadeData& Cascade = Cascades[i];
+
+		if (bFitToSmoke)
+		{
+			// Shadows are only sampled inside smoke, a cascade without smoke in its range is never read
+			Cascade.SmokeBounds = ComputeCascadeSmokeBounds(Cascade, CameraPosition, LightRight, LightUp, NormalizedLightDir, SmokeBounds);
+			if (!Cascade.SmokeBounds.IsValid)
+			{
+				Cascade.bNeedsCapture = false;
+				continue;
+			}
+		}
+
+		if (!bEnablePriorityUpdate || !Cascade.bHasCapture)
+		{
+			Cascade.bNeedsCapture = true;
+			continue;
+		}
+
+		// Stale cascades keep their capture-time matrices, a turned light would split shadows between cascades
+		if (FVector::DotProduct(NormalizedLightDir, Cascade.CaptureLightDirection) < LightRecaptureCosine)
+		{
+			Cascade.bNeedsCapture = true;
+			continue;
+		}
+
+		if (bFitToSmoke)
+		{
+			// The smoke in range must stay inside the captured box
+			const FBox& Captured = Cascade.CaptureBounds;
+			const FBox& Smoke = Cascade.SmokeBounds;
+			const bool bCovered = Captured.IsValid
+				&& Smoke.Min.X >= Captured.Min.X && Smoke.Min.Y >= Captured.Min.Y && Smoke.Min.Z >= Captured.Min.Z
+				&& Smoke.Max.X <= Captured.Max.X && Smoke.Max.Y <= Captured.Max.Y && Smoke.Max.Z <= Captured.Max.Z;
+			if (!bCovered)
+			{
+				Cascade.bNeedsCapture = true;
+				continue;
+			}
+		}
+		else
+		{
+			// The split sphere around the current camera must stay inside the captured ortho box.
+			// Movement along the light axis is covered by the depth range (see CalculateViewProjectionMatrix).
+			const FVector CameraOffset = FVector::VectorPlaneProject(CameraPosition - Cascade.CaptureCameraPosition, NormalizedLightDir);
+			const float AllowedOffset = Cascade.OrthoWidth * 0.5f - Cascade.FarPlane;
+			if (CameraOffset.SizeSquared() > FMath::Square(AllowedOffset))
+			{
+				Cascade.bNeedsCapture = true;
+				continue;
+			}
+		}
+
+		// The index offset staggers cascades sharing an interval
+		Cascade.bNeedsCapture = (FrameNumber + (uint32)i) % (uint32)GetCaptureInterval(i) == 0;
 	}
 }
 
+FBox FIVSmokeCSMRenderer::ComputeCascadeSmokeBounds(
+	const FIVSmokeCascadeData& Cascade,
+	const FVector& CameraPosition,
+	const FVector& LightRight,
+	const FVector& LightUp,
+	const FVector& LightDirection,
+	TConstArrayView<FBox> SmokeBounds) const
+{
+	// Cascade selection uses the distance to the camera, the previous cascade blends into this one.
+	// Boxes are clipped to the cube around the split sphere rather than the sphere itself, which is
+	// conservative: the fit may include smoke in the cube corners that this cascade never shades.
+	const double RangeNear = Cascade.CascadeIndex > 0 ? Cascade.NearPlane * (1.0 - CascadeBlendRange) : 0.0;
+	const double RangeFar = Cascade.FarPlane;
+	const FBox RangeBox = FBox::BuildAABB(CameraPosition, FVector(RangeFar));
+
+	FBox LightSpaceBounds(ForceInit);
+	for (const FBox& Bounds : SmokeBounds)
+	{
+		// Entirely beyond the split distance, or entirely closer than the range
+		const FVector FarthestOffset = FVector::Max((CameraPosition - Bounds.Min).GetAbs(), (Bounds.Max - CameraPosition).GetAbs());
+		if (Bounds.ComputeSquaredDistanceToPoint(CameraPosition) > FMath::Square(RangeFar) || FarthestOffset.SizeSquared() < FMath::Square(RangeNear))
+		{
+			continue;
+		}
+
+		const FBox Clipped = Bounds.Overlap(RangeBox);
+		if (!Clipped.IsValid)
+		{
+			continue;
+		}
+
+		for (int32 Corner = 0; Corner < 8; Corner++)
+		{
+			const FVector Point(
+				(Corner & 1) ? Clipped.Max.X : Clipped.Min.X,
+				(Corner & 2) ? Clipped.Max.Y : Clipped.Min.Y,
+				(Corner & 4) ? Clipped.Max.Z : Clipped.Min.Z);
+			LightSpaceBounds += FVector(
+				FVector::DotProduct(Point, LightRight),
+				FVector::DotProduct(Point, LightUp),
+				FVector::DotProduct(Point, LightDirection));
+		}
+	}
+
+	return LightSpaceBounds;
+}
+
+void FIVSmokeCSMRenderer::ComputeLightBasis(const FVector& LightDirection, FVector& OutLightRight, FVector& OutLightUp)
+{
+	OutLightRight = FVector::CrossProduct(LightDirection, FVector::UpVector);
+	if (OutLightRight.IsNearlyZero())
+	{
+		OutLightRight = FVector::CrossProduct(LightDirection, FVector::ForwardVector);
+	}
+	OutLightRight.Normalize();
+	OutLightUp = FVector::CrossProduct(OutLightRight, -LightDirection).GetSafeNormal();
+}
+
+int32 FIVSmokeCSMRenderer::GetCaptureInterval(int32 CascadeIndex) const
+{
+	if (!bEnablePriorityUpdate)
+	{
+		return 1;
+	}
+
+	// Interval grows linearly from the near to the far cascade
+	const int32 NumCascades = Cascades.Num();
+	const float Alpha = NumCascades > 1 ? (float)CascadeIndex / (float)(NumCascades - 1) : 0.0f;
+	return FMath::Max(1, FMath::RoundToInt(FMath::Lerp((float)NearCascadeUpdateInterval, (float)FarCascadeUpdateInterval, Alpha)));
+}
+
 void FIVSmokeCSMRenderer::UpdateCascadeCapture(
 	int32 CascadeIndex,
 	const FVector& CameraPosition,
@@ -226,26 +356,13 @@ void FIVSmokeCSMRenderer::UpdateCascadeCapture(
 		NormalizedLightDir = FVector(0.0f, 0.0f, 1.0f);
 	}
 
-	//~==========================================================================
-	// CSM Camera Positioning
-	//
-	// OrthoWidth covers the cascade's view frustum at its far distance.
-	// For a reasonable FOV (~90°), width at distance D is roughly 2*D.
-	float NewOrthoWidth = Cascade.FarPlane * 2.0f;
-
 	// Calculate light view axes
 	FVector LightForward = -NormalizedLightDir; // Camera looks opposite to light direction
-	FVector LightRight = FVector::CrossProduct(NormalizedLightDir, FVector::UpVector);
-	if (LightRight.IsNearlyZero())
-	{
-		LightRight = FVector::CrossProduct(NormalizedLightDir, FVector::ForwardVector);
-	}
-	LightRight.Normalize();
-	FVector LightUp = FVector::CrossProduct(LightRight, LightForward).GetSafeNormal();
+	FVector LightRight, LightUp;
+	ComputeLightBasis(NormalizedLightDir, LightRight, LightUp);
 
 	// Position shadow camera far enough to see all shadow casters
 	float CaptureDistance = MaxShadowDistance * 1.5f;
-	FVector BaseCapturePosition = CameraPosition + NormalizedLightDir * CaptureDistance;
 
 	//~==========================================================================
 	// Texel Snapping - Use SMALLEST cascade's texel size for ALL cascades
@@ -256,22 +373,85 @@ void FIVSmokeCSMRenderer::UpdateCascadeCapture(
 	// 3. Smooth cascade transitions without edge artifacts
 	//
 	// Uses cascade 0's texel size (smallest = finest grid) for consistency.
-	double SmallestOrthoWidth = (double)Cascades[0].FarPlane * 2.0;
+	double SmallestOrthoWidth = (double)Cascades[0].FarPlane * 2.0 * GetCoverageScale(0);
 	double TexelSize = SmallestOrthoWidth / (double)CurrentResolution;
 
-	// Project PLAYER CAMERA position onto light view axes
-	double PlayerRightOffset = FVector::DotProduct(CameraPosition, LightRight);
-	double PlayerUpOffset = FVector::DotProduct(CameraPosition, LightUp);
+	// OrthoWidth covers the cascade's view frustum at its far distance.
+	// For a reasonable FOV (~90°), width at distance D is roughly 2*D.
+	// Priority update pads it, so the camera can move while the cascade is stale.
+	float NewOrthoWidth = Cascade.FarPlane * 2.0f * GetCoverageScale(CascadeIndex);
+	FVector SnappedPosition;
+
+	//~==========================================================================
+	// Smoke Fitted Width
+	//
+	// Fitted widths are SmallestOrthoWidth times a power of two, so a fitted cascade's texels
+	// are either multiples or fractions of the unified texel. Snapping to the coarser of the two
+	// keeps the capture on the unified grid and on its own texel grid at once.
+	// A fit that would not be smaller than the full split sphere falls back to it.
+	double FittedWidth = 0.0;
+	double FittedSnapSize = TexelSize;
+	if (bFitToSmoke && Cascade.SmokeBounds.IsValid)
+	{
+		const FVector SmokeExtent = Cascade.SmokeBounds.GetSize();
+		const double SmokeWidth = FMath::Max(SmokeExtent.X, SmokeExtent.Y) * GetCoverageScale(CascadeIndex);
+		const double MinWidth = FMath::Max(SmokeWidth + 2.0 * TexelSize, (double)MinFittedOrthoWidth);
+		FittedWidth = SmallestOrthoWidth * FMath::Pow(2.0, FMath::CeilToDouble(FMath::Log2(MinWidth / SmallestOrthoWidth)));
+		FittedSnapSize = FMath::Max(TexelSize, FittedWidth / (double)CurrentResolution);
+
+		// Snapping moves the center by up to one snap step, keep that much margin on both sides
+		if (SmokeWidth + 2.0 * FittedSnapSize > FittedWidth)
+		{
+			FittedWidth *= 2.0;
+			FittedSnapSize = FMath::Max(TexelSize, FittedWidth / (double)CurrentResolution);
+		}
+	}
+
+	if (FittedWidth > 0.0 && FittedWidth < NewOrthoWidth)
+	{
+		//~======================================================================
+		// Smoke Fitted Positioning
+		//
+		// OrthoWidth covers the smoke inside the split range instead of the whole split sphere.
+		NewOrthoWidth = (float)FittedWidth;
+
+		const FVector SmokeCenter = Cascade.SmokeBounds.GetCenter();
+		const double SnappedRight = FMath::FloorToDouble(SmokeCenter.X / FittedSnapSize) * FittedSnapSize;
+		const double SnappedUp = FMath::FloorToDouble(SmokeCenter.Y / FittedSnapSize) * FittedSnapSize;
+		const double CameraDepth = Cascade.SmokeBounds.Max.Z + CaptureDistance;
+
+		SnappedPosition = LightRight * SnappedRight + LightUp * SnappedUp + NormalizedLightDir * CameraDepth;
+	}
+	else
+	{
+		//~======================================================================
+		// CSM Camera Positioning
+		FVector BaseCapturePosition = CameraPosition + NormalizedLightDir * CaptureDistance;
+
+		// Project PLAYER CAMERA position onto light view axes
+		double PlayerRightOffset = FVector::DotProduct(CameraPosition, LightRight);
+		double PlayerUpOffset = FVector::DotProduct(CameraPosition, LightUp);
 
-	// Snap to unified grid (same for all cascades)
-	double SnappedRight = FMath::FloorToDouble(PlayerRightOffset / TexelSize) * TexelSize;
-	double SnappedUp = FMath::FloorToDouble(PlayerUpOffset / TexelSize) * TexelSize;
+		// Snap to unified grid (same for all cascades)
+		double SnappedRight = FMath::FloorToDouble(PlayerRightOffset / TexelSize) * TexelSize;
+		double SnappedUp = FMath::FloorToDouble(PlayerUpOffset / TexelSize) * TexelSize;
 
-	// Calculate adjustment
-	FVector SnapAdjustment = LightRight * (float)(SnappedRight - PlayerRightOffset)
-	                       + LightUp * (float)(SnappedUp - PlayerUpOffset);
+		// Calculate adjustment
+		FVector SnapAdjustment = LightRight * (float)(SnappedRight - PlayerRightOffset)
+		                       + LightUp * (float)(SnappedUp - PlayerUpOffset);
+
+		SnappedPosition = BaseCapturePosition + SnapAdjustment;
+	}
 
-	FVector SnappedPosition = BaseCapturePosition + SnapAdjustment;
+	// Light space box the capture covers, checked against the smoke bounds by UpdateCascadePriorities
+	const FVector CaptureCenter(
+		FVector::DotProduct(SnappedPosition, LightRight),
+		FVector::DotProduct(SnappedPosition, LightUp),
+		FVector::DotProduct(SnappedPosition, NormalizedLightDir));
+	const double HalfWidth = NewOrthoWidth * 0.5;
+	Cascade.CaptureBounds = FBox(
+		CaptureCenter - FVector(HalfWidth, HalfWidth, MaxShadowDistance * 3.0),
+		CaptureCenter + FVector(HalfWidth, HalfWidth, -1.0));
 
 	//~==========================================================================
 	// Store current frame values (used by both capture and shader)
@@ -290,6 +470,9 @@ void FIVSmokeCSMRenderer::UpdateCascadeCapture(
 	//~==========================================================================
 	// Synchronous Capture - ensures VP matrix and depth texture match
 	Cascade.CaptureComponent->CaptureScene();
+	Cascade.CaptureCameraPosition = CameraPosition;
+	Cascade.CaptureLightDirection = NormalizedLightDir;
+	Cascade.bHasCapture = true;
 
 	UE_LOG(LogIVSmokeCSM, Verbose, TEXT("[FIVSmokeCSMRenderer::UpdateCascadeCapture] Cascade %d: Near=%.0f, Far=%.0f, OrthoWidth=%.0f"),
 		CascadeIndex, Cascade.NearPlane, Cascade.FarPlane, NewOrthoWidth);
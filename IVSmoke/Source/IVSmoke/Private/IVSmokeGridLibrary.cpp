@@ -3,3 +3,80 @@
 #include "IVSmokeGridLibrary.h"
 
 const FIntVector UIVSmokeGridLibrary::InvalidGridPos(-1, -1, -1);
+
+bool UIVSmokeGridLibrary::TraceVoxelBitSpan(const TArray<uint64>& VoxelBitArray, const FIntVector& Resolution, const FVector& GridOrigin, const FVector& GridDirection,
+	double TStart, double TEnd, double Padding, double& OutEntryDistance, double& OutExitDistance)
+{
+	// 1. Clip to the grid
+	double GridTNear, GridTFar;
+	if (!RayBoxIntersection(FVector::ZeroVector, FVector(Resolution), GridOrigin, GridDirection, GridTNear, GridTFar))
+	{
+		return false;
+	}
+
+	const double TraceStart = FMath::Max(TStart, GridTNear);
+	const double TraceEnd = FMath::Min(TEnd, GridTFar);
+	if (TraceStart > TraceEnd)
+	{
+		return false;
+	}
+
+	// 2. DDA over the voxel bits between the clipped bounds
+	const FVector StartPos = GridOrigin + GridDirection * TraceStart;
+	FIntVector Cell;
+	FIntVector Step;
+	FVector TNext;
+	FVector TDelta;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		Cell[Axis] = FMath::Clamp(FMath::FloorToInt32(StartPos[Axis]), 0, Resolution[Axis] - 1);
+		if (FMath::IsNearlyZero(GridDirection[Axis]))
+		{
+			Step[Axis] = 0;
+			TNext[Axis] = TNumericLimits<double>::Max();
+			TDelta[Axis] = TNumericLimits<double>::Max();
+			continue;
+		}
+
+		Step[Axis] = GridDirection[Axis] > 0.0 ? 1 : -1;
+		const double Boundary = Cell[Axis] + (Step[Axis] > 0 ? 1 : 0);
+		TNext[Axis] = TraceStart + (Boundary - StartPos[Axis]) / GridDirection[Axis];
+		TDelta[Axis] = FMath::Abs(1.0 / GridDirection[Axis]);
+	}
+
+	bool bFoundVoxel = false;
+	double TCellEnter = TraceStart;
+	while (TCellEnter <= TraceEnd)
+	{
+		const int32 Axis = TNext.X < TNext.Y ? (TNext.X < TNext.Z ? 0 : 2) : (TNext.Y < TNext.Z ? 1 : 2);
+		const double TCellExit = FMath::Min(TNext[Axis], TraceEnd);
+
+		if (IsVoxelBitSet(VoxelBitArray, Cell, Resolution))
+		{
+			if (!bFoundVoxel)
+			{
+				OutEntryDistance = TCellEnter;
+				bFoundVoxel = true;
+			}
+			OutExitDistance = TCellExit;
+		}
+
+		Cell[Axis] += Step[Axis];
+		if (Step[Axis] == 0 || Cell[Axis] < 0 || Cell[Axis] >= Resolution[Axis])
+		{
+			break;
+		}
+		TCellEnter = TNext[Axis];
+		TNext[Axis] += TDelta[Axis];
+	}
+
+	if (!bFoundVoxel)
+	{
+		return false;
+	}
+
+	// 3. Trilinear filtering reaches past the set voxels, pad so the span covers the visible edge
+	OutEntryDistance = FMath::Max(OutEntryDistance - Padding, TStart);
+	OutExitDistance = FMath::Min(OutExitDistance + Padding, TEnd);
+	return true;
+}
@@ -0,0 +1,396 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#include "IVSmokeHoleAtlas.h"
+
+#include "IVSmoke.h"
+#include "IVSmokeRenderer.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+
+//~============================================================================
+// Layout
+#pragma region Layout
+FIntVector FIVSmokeHoleAtlasLayout::GetAtlasResolution() const
+{
+	return FIntVector(
+		SlotResolution.X * SlotCount.X + FIVSmokeHoleAtlas::SlotInterval * (SlotCount.X - 1),
+		SlotResolution.Y * SlotCount.Y + FIVSmokeHoleAtlas::SlotInterval * (SlotCount.Y - 1),
+		SlotResolution.Z * SlotCount.Z + FIVSmokeHoleAtlas::SlotInterval * (SlotCount.Z - 1)
+	);
+}
+
+FIntVector FIVSmokeHoleAtlasLayout::GetSlotOffset(const int32 Slot) const
+{
+	const FIntVector SlotCoord(
+		Slot % SlotCount.X,
+		(Slot / SlotCount.X) % SlotCount.Y,
+		Slot / (SlotCount.X * SlotCount.Y)
+	);
+	return SlotCoord * (SlotResolution + FIntVector(FIVSmokeHoleAtlas::SlotInterval));
+}
+#pragma endregion
+
+#if !UE_SERVER
+FIVSmokeHoleAtlas& FIVSmokeHoleAtlas::Get()
+{
+	static FIVSmokeHoleAtlas Instance;
+	return Instance;
+}
+
+//~============================================================================
+// Game Thread
+#pragma region Game Thread
+int32 FIVSmokeHoleAtlas::AllocateSlot(const FIntVector& Resolution, const EPixelFormat Format)
+{
+	check(IsInGameThread());
+
+	// Freed slots were cleared on release and are reused first
+	const bool bReuse = FreeSlots.Num() > 0;
+	const int32 Slot = bReuse ? FreeSlots.Pop() : NumAllocatedSlots;
+	const int32 RequiredCapacity = FMath::Max(NumAllocatedSlots + (bReuse ? 0 : 1), 1);
+
+	FIVSmokeHoleAtlasLayout NewLayout = Layout;
+	NewLayout.SlotResolution = Layout.IsValid()
+		? FIntVector(
+			FMath::Max(Layout.SlotResolution.X, Resolution.X),
+			FMath::Max(Layout.SlotResolution.Y, Resolution.Y),
+			FMath::Max(Layout.SlotResolution.Z, Resolution.Z))
+		: Resolution;
+	NewLayout.Format = Format;
+	if (NewLayout.SlotResolution != Layout.SlotResolution || Layout.GetCapacity() < RequiredCapacity)
+	{
+		const int32 Capacity = FMath::Max<int32>(MinCapacity, FMath::RoundUpToPowerOfTwo(RequiredCapacity));
+		NewLayout.SlotCount = FIVSmokeRenderer::GetAtlasTexCount(NewLayout.SlotResolution, Capacity, SlotInterval, MaxAtlasSize);
+		if (NewLayout.GetCapacity() < RequiredCapacity)
+		{
+			UE_LOG(LogIVSmoke, Verbose, TEXT("[FIVSmokeHoleAtlas::AllocateSlot] Hole atlas is full (%d slots of %s)."),
+				NewLayout.GetCapacity(), *NewLayout.SlotResolution.ToString());
+			if (bReuse)
+			{
+				FreeSlots.Add(Slot);
+			}
+			return INDEX_NONE;
+		}
+	}
+
+	if (!bReuse)
+	{
+		++NumAllocatedSlots;
+	}
+	DistortionSlots.SetNum(NumAllocatedSlots, false);
+
+	Relayout(NewLayout);
+	return Slot;
+}
+
+void FIVSmokeHoleAtlas::FreeSlot(const int32 Slot)
+{
+	check(IsInGameThread());
+
+	if (Slot == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Clearing distortion already clears the slot
+	if (DistortionSlots.IsValidIndex(Slot) && DistortionSlots[Slot])
+	{
+		SetSlotDistortion(Slot, false);
+	}
+	else
+	{
+		ClearSlot(Slot);
+	}
+	FreeSlots.Add(Slot);
+
+	ShrinkToLiveSlots();
+}
+
+void FIVSmokeHoleAtlas::ShrinkToLiveSlots()
+{
+	// Only the tail can go, slot indices of live slots must stay valid
+	while (NumAllocatedSlots > 0 && FreeSlots.Remove(NumAllocatedSlots - 1) > 0)
+	{
+		--NumAllocatedSlots;
+	}
+	DistortionSlots.SetNum(NumAllocatedSlots, false);
+
+	// Nothing left, drop the atlas. The next slot picks its resolution again.
+	if (NumAllocatedSlots == 0)
+	{
+		FIVSmokeHoleAtlasLayout EmptyLayout;
+		EmptyLayout.Format = Layout.Format;
+		Relayout(EmptyLayout);
+		return;
+	}
+
+	// Shrink once the live range fits a quarter, so a slot freed and allocated again does not flip the layout
+	const int32 Capacity = FMath::Max<int32>(MinCapacity, FMath::RoundUpToPowerOfTwo(NumAllocatedSlots));
+	if (Capacity * 4 <= Layout.GetCapacity())
+	{
+		FIVSmokeHoleAtlasLayout NewLayout = Layout;
+		NewLayout.SlotCount = FIVSmokeRenderer::GetAtlasTexCount(Layout.SlotResolution, Capacity, SlotInterval, MaxAtlasSize);
+		Relayout(NewLayout);
+	}
+}
+
+void FIVSmokeHoleAtlas::ClearSlot(const int32 Slot)
+{
+	check(IsInGameThread());
+
+	if (Slot == INDEX_NONE)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(IVSmokeHoleAtlasClearSlot)(
+		[this, Slot](FRHICommandListImmediate& RHICmdList)
+		{
+			FRDGBuilder GraphBuilder(RHICmdList);
+			ClearSlot_RenderThread(GraphBuilder, Slot);
+			GraphBuilder.Execute();
+		}
+	);
+}
+
+void FIVSmokeHoleAtlas::SetFormat(const EPixelFormat Format)
+{
+	check(IsInGameThread());
+
+	FIVSmokeHoleAtlasLayout NewLayout = Layout;
+	NewLayout.Format = Format;
+	Relayout(NewLayout);
+}
+
+void FIVSmokeHoleAtlas::SetSlotDistortion(const int32 Slot, const bool bHasDistortion)
+{
+	check(IsInGameThread());
+
+	if (!DistortionSlots.IsValidIndex(Slot) || DistortionSlots[Slot] == bHasDistortion)
+	{
+		return;
+	}
+
+	DistortionSlots[Slot] = bHasDistortion;
+	NumDistortionSlots += bHasDistortion ? 1 : -1;
+
+	// Other slots may keep the distortion atlas alive, so drop what this slot wrote into it
+	if (!bHasDistortion)
+	{
+		ClearSlot(Slot);
+	}
+	UpdateRenderDistortion();
+}
+
+void FIVSmokeHoleAtlas::Relayout(const FIVSmokeHoleAtlasLayout& NewLayout)
+{
+	if (NewLayout == Layout)
+	{
+		return;
+	}
+	Layout = NewLayout;
+
+	TArray<int32> LiveSlots;
+	LiveSlots.Reserve(NumAllocatedSlots);
+	for (int32 Slot = 0; Slot < NumAllocatedSlots; ++Slot)
+	{
+		if (!FreeSlots.Contains(Slot))
+		{
+			LiveSlots.Add(Slot);
+		}
+	}
+
+	// Textures are re-created cleared on next use. When only the capacity changes, live slots are copied over,
+	// otherwise their owners re-carve on their next tick (owners with active holes carve every tick).
+	ENQUEUE_RENDER_COMMAND(IVSmokeHoleAtlasRelayout)(
+		[this, NewLayout, LiveSlots = MoveTemp(LiveSlots)](FRHICommandListImmediate& RHICmdList)
+		{
+			const FIVSmokeHoleAtlasLayout OldLayout = RenderLayout;
+			const bool bCopySlots = MaskAtlas.IsValid() && LiveSlots.Num() > 0 && NewLayout.IsValid()
+				&& OldLayout.SlotResolution == NewLayout.SlotResolution && OldLayout.Format == NewLayout.Format;
+			if (!bCopySlots)
+			{
+				RenderLayout = NewLayout;
+				MaskAtlas.SafeRelease();
+				DistortionAtlas.SafeRelease();
+				return;
+			}
+
+			FRDGBuilder GraphBuilder(RHICmdList);
+			const FRDGTextureRef OldMaskAtlas = GraphBuilder.RegisterExternalTexture(MaskAtlas);
+			const FRDGTextureRef OldDistortionAtlas = DistortionAtlas.IsValid() ? GraphBuilder.RegisterExternalTexture(DistortionAtlas) : nullptr;
+			MaskAtlas.SafeRelease();
+			DistortionAtlas.SafeRelease();
+
+			RenderLayout = NewLayout;
+			const FRDGTextureRef NewMaskAtlas = RegisterMaskAtlas(GraphBuilder);
+			const FRDGTextureRef NewDistortionAtlas = OldDistortionAtlas ? RegisterDistortionAtlas(GraphBuilder) : nullptr;
+
+			FRHICopyTextureInfo CopyInfo;
+			CopyInfo.Size = NewLayout.SlotResolution;
+			for (const int32 Slot : LiveSlots)
+			{
+				if (Slot >= OldLayout.GetCapacity() || Slot >= NewLayout.GetCapacity())
+				{
+					continue;
+				}
+				CopyInfo.SourcePosition = OldLayout.GetSlotOffset(Slot);
+				CopyInfo.DestPosition = NewLayout.GetSlotOffset(Slot);
+				AddCopyTexturePass(GraphBuilder, OldMaskAtlas, NewMaskAtlas, CopyInfo);
+				if (NewDistortionAtlas)
+				{
+					AddCopyTexturePass(GraphBuilder, OldDistortionAtlas, NewDistortionAtlas, CopyInfo);
+				}
+			}
+			GraphBuilder.Execute();
+		}
+	);
+}
+
+void FIVSmokeHoleAtlas::UpdateRenderDistortion()
+{
+	const bool bDistortion = NumDistortionSlots > 0;
+	ENQUEUE_RENDER_COMMAND(IVSmokeHoleAtlasUpdateDistortion)(
+		[this, bDistortion](FRHICommandListImmediate& RHICmdList)
+		{
+			bRenderDistortion = bDistortion;
+			if (!bRenderDistortion)
+			{
+				DistortionAtlas.SafeRelease();
+			}
+		}
+	);
+}
+
+void FIVSmokeHoleAtlas::Release()
+{
+	ENQUEUE_RENDER_COMMAND(IVSmokeHoleAtlasRelease)(
+		[this](FRHICommandListImmediate& RHICmdList)
+		{
+			MaskAtlas.SafeRelease();
+			DistortionAtlas.SafeRelease();
+		}
+	);
+}
+#pragma endregion
+
+//~============================================================================
+// Render Thread
+#pragma region Render Thread
+FRDGTextureRef FIVSmokeHoleAtlas::RegisterMaskAtlas(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	if (!RenderLayout.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (MaskAtlas.IsValid())
+	{
+		return GraphBuilder.RegisterExternalTexture(MaskAtlas);
+	}
+
+	const FRDGTextureDesc AtlasDesc = FRDGTextureDesc::Create3D(
+		RenderLayout.GetAtlasResolution(),
+		RenderLayout.Format,
+		FClearValueBinding::None,
+		TexCreate_ShaderResource | TexCreate_UAV
+	);
+	const FRDGTextureRef Texture = GraphBuilder.CreateTexture(AtlasDesc, TEXT("IVSmoke_HoleAtlas"));
+
+	// Density mask = 1 (no hole) with zero distortion, including the padding between slots
+	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Texture),
+		RenderLayout.IsCompact() ? FLinearColor(1.0f, 1.0f, 1.0f, 1.0f) : FLinearColor(0.0f, 0.0f, 0.0f, 1.0f));
+
+	MaskAtlas = GraphBuilder.ConvertToExternalTexture(Texture);
+	return Texture;
+}
+
+FRDGTextureRef FIVSmokeHoleAtlas::RegisterDistortionAtlas(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	if (!RenderLayout.IsValid() || !RenderLayout.IsCompact() || !bRenderDistortion)
+	{
+		return nullptr;
+	}
+
+	if (DistortionAtlas.IsValid())
+	{
+		return GraphBuilder.RegisterExternalTexture(DistortionAtlas);
+	}
+
+	const FRDGTextureDesc AtlasDesc = FRDGTextureDesc::Create3D(
+		RenderLayout.GetAtlasResolution(),
+		PF_A2B10G10R10,
+		FClearValueBinding::None,
+		TexCreate_ShaderResource | TexCreate_UAV
+	);
+	const FRDGTextureRef Texture = GraphBuilder.CreateTexture(AtlasDesc, TEXT("IVSmoke_HoleDistortionAtlas"));
+
+	// 0.5 encodes zero distortion
+	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Texture), FLinearColor(0.5f, 0.5f, 0.5f, 0.0f));
+
+	DistortionAtlas = GraphBuilder.ConvertToExternalTexture(Texture);
+	return Texture;
+}
+
+int64 FIVSmokeHoleAtlas::GetMemorySize_RenderThread() const
+{
+	const FIntVector AtlasResolution = RenderLayout.GetAtlasResolution();
+	int64 TotalSize = 0;
+	if (MaskAtlas.IsValid())
+	{
+		TotalSize += CalculateImageBytes(AtlasResolution.X, AtlasResolution.Y, AtlasResolution.Z, RenderLayout.Format);
+	}
+	if (DistortionAtlas.IsValid())
+	{
+		TotalSize += CalculateImageBytes(AtlasResolution.X, AtlasResolution.Y, AtlasResolution.Z, PF_A2B10G10R10);
+	}
+	return TotalSize;
+}
+
+void FIVSmokeHoleAtlas::ClearSlot_RenderThread(FRDGBuilder& GraphBuilder, const int32 Slot)
+{
+	// Atlases that do not exist yet are created cleared
+	if (!RenderLayout.IsValid() || Slot >= RenderLayout.GetCapacity() || (!MaskAtlas.IsValid() && !DistortionAtlas.IsValid()))
+	{
+		return;
+	}
+
+	FRHICopyTextureInfo CopyInfo;
+	CopyInfo.Size = RenderLayout.SlotResolution;
+	CopyInfo.SourcePosition = FIntVector::ZeroValue;
+	CopyInfo.DestPosition = RenderLayout.GetSlotOffset(Slot);
+
+	if (MaskAtlas.IsValid())
+	{
+		const FRDGTextureDesc ClearDesc = FRDGTextureDesc::Create3D(
+			RenderLayout.SlotResolution,
+			RenderLayout.Format,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		const FRDGTextureRef ClearTexture = GraphBuilder.CreateTexture(ClearDesc, TEXT("IVSmoke_HoleSlotClear"));
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(ClearTexture),
+			RenderLayout.IsCompact() ? FLinearColor(1.0f, 1.0f, 1.0f, 1.0f) : FLinearColor(0.0f, 0.0f, 0.0f, 1.0f));
+		AddCopyTexturePass(GraphBuilder, ClearTexture, GraphBuilder.RegisterExternalTexture(MaskAtlas), CopyInfo);
+	}
+
+	if (DistortionAtlas.IsValid())
+	{
+		const FRDGTextureDesc ClearDesc = FRDGTextureDesc::Create3D(
+			RenderLayout.SlotResolution,
+			PF_A2B10G10R10,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		const FRDGTextureRef ClearTexture = GraphBuilder.CreateTexture(ClearDesc, TEXT("IVSmoke_HoleSlotDistortionClear"));
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(ClearTexture), FLinearColor(0.5f, 0.5f, 0.5f, 0.0f));
+		AddCopyTexturePass(GraphBuilder, ClearTexture, GraphBuilder.RegisterExternalTexture(DistortionAtlas), CopyInfo);
+	}
+}
+#pragma endregion
+#endif
@@ -4,11 +4,129 @@
 #include "IVSmokeHolePreset.h"
 #include "IVSmokeHoleGeneratorComponent.h"
 
+namespace
+{
+	/** Quantization frame shared by every item serialized in one FIVSmokeHoleArray::NetDeltaSerialize call. */
+	struct FIVSmokeHoleNetContext
+	{
+		/** Positions inside are sent as 16 bits per axis. Invalid box = always full precision. */
+		FBox3f Bounds = FBox3f(ForceInit);
+
+		/** Synced server time used to unwrap expiration ticks. */
+		float ServerTime = 0.0f;
+	};
+
+	/** Expiration tick rate. 16 bits wrap every 1024 seconds, far above any hole duration. */
+	constexpr float ExpirationTicksPerSecond = 64.0f;
+
+	constexpr float MaxQuantizedPosition = static_cast<float>(MAX_uint16);
+
+	thread_local const FIVSmokeHoleNetContext* GActiveHoleNetContext = nullptr;
+
+	bool QuantizePosition(const FBox3f& Bounds, const FVector3f& Position, uint16 OutQuantized[3])
+	{
+		if (!Bounds.IsValid || !Bounds.IsInsideOrOn(Position))
+		{
+			return false;
+		}
+
+		const FVector3f Size = Bounds.GetSize();
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const float Alpha = Size[Axis] > UE_SMALL_NUMBER ? (Position[Axis] - Bounds.Min[Axis]) / Size[Axis] : 0.0f;
+			OutQuantized[Axis] = static_cast<uint16>(FMath::RoundToInt(FMath::Clamp(Alpha, 0.0f, 1.0f) * MaxQuantizedPosition));
+		}
+		return true;
+	}
+
+	FVector3f DequantizePosition(const FBox3f& Bounds, const uint16 Quantized[3])
+	{
+		const FVector3f Alpha(Quantized[0], Quantized[1], Quantized[2]);
+		return Bounds.Min + Bounds.GetSize() * (Alpha / MaxQuantizedPosition);
+	}
+
+	void SerializePosition(FArchive& Ar, const FIVSmokeHoleNetContext& Context, const bool bQuantized, FVector3f& Position)
+	{
+		if (!bQuantized)
+		{
+			Ar << Position;
+			return;
+		}
+
+		uint16 Quantized[3] = {};
+		if (Ar.IsSaving())
+		{
+			QuantizePosition(Context.Bounds, Position, Quantized);
+		}
+		Ar << Quantized[0] << Quantized[1] << Quantized[2];
+		if (Ar.IsLoading())
+		{
+			Position = DequantizePosition(Context.Bounds, Quantized);
+		}
+	}
+}
+
+bool FIVSmokeHoleData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	static const FIVSmokeHoleNetContext FallbackContext;
+	const FIVSmokeHoleNetContext& Context = GActiveHoleNetContext ? *GActiveHoleNetContext : FallbackContext;
+
+	// 1. Header: [bQuantized:1][bHasEndPosition:1][PresetID:8]
+	constexpr uint32 QuantizedBit = 1u << 0;
+	constexpr uint32 EndPositionBit = 1u << 1;
+	constexpr uint32 PresetShift = 2;
+	constexpr uint32 HeaderBits = PresetShift + 8;
+
+	uint32 Header = 0;
+	if (Ar.IsSaving())
+	{
+		uint16 Unused[3];
+		const bool bHasEndPosition = !EndPosition.Equals(Position, 0.0f);
+		const bool bQuantized = QuantizePosition(Context.Bounds, Position, Unused)
+			&& (!bHasEndPosition || QuantizePosition(Context.Bounds, EndPosition, Unused));
+
+		Header = (bQuantized ? QuantizedBit : 0u) | (bHasEndPosition ? EndPositionBit : 0u) | (static_cast<uint32>(PresetID) << PresetShift);
+	}
+	Ar.SerializeBits(&Header, HeaderBits);
+
+	const bool bQuantized = (Header & QuantizedBit) != 0;
+	const bool bHasEndPosition = (Header & EndPositionBit) != 0;
+	PresetID = static_cast<uint8>(Header >> PresetShift);
+
+	// 2. Positions. Explosion and dynamic holes share Position and EndPosition.
+	SerializePosition(Ar, Context, bQuantized, Position);
+	if (bHasEndPosition)
+	{
+		SerializePosition(Ar, Context, bQuantized, EndPosition);
+	}
+	else if (Ar.IsLoading())
+	{
+		EndPosition = Position;
+	}
+
+	// 3. Expiration as a wrapped tick, unwrapped around the receiver's synced time.
+	uint16 ExpirationTick = 0;
+	if (Ar.IsSaving())
+	{
+		ExpirationTick = static_cast<uint16>(FMath::RoundToInt64(ExpirationServerTime * ExpirationTicksPerSecond));
+	}
+	Ar << ExpirationTick;
+	if (Ar.IsLoading())
+	{
+		const int64 ReferenceTick = FMath::RoundToInt64(Context.ServerTime * ExpirationTicksPerSecond);
+		const int16 TickOffset = static_cast<int16>(static_cast<uint16>(ExpirationTick - static_cast<uint16>(ReferenceTick)));
+		ExpirationServerTime = static_cast<float>(ReferenceTick + TickOffset) / ExpirationTicksPerSecond;
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
 void FIVSmokeHoleData::PostReplicatedAdd(const FIVSmokeHoleArray& InArray)
 {
 	if (InArray.OwnerComponent)
 	{
-		InArray.OwnerComponent->MarkHoleTextureDirty();
+		InArray.OwnerComponent->MarkHoleBufferDirty();
 	}
 }
 
@@ -16,7 +134,7 @@ void FIVSmokeHoleData::PostReplicatedChange(const FIVSmokeHoleArray& InArray)
 {
 	if (InArray.OwnerComponent)
 	{
-		InArray.OwnerComponent->MarkHoleTextureDirty();
+		InArray.OwnerComponent->MarkHoleBufferDirty();
 	}
 }
 
@@ -24,17 +142,113 @@ void FIVSmokeHoleData::PreReplicatedRemove(const FIVSmokeHoleArray& InArray)
 {
 	if (InArray.OwnerComponent)
 	{
-		InArray.OwnerComponent->MarkHoleTextureDirty();
+		InArray.OwnerComponent->MarkHoleBufferDirty();
 	}
 }
 
+bool FIVSmokeHoleArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	FIVSmokeHoleNetContext Context;
+	if (OwnerComponent)
+	{
+		Context.Bounds = OwnerComponent->GetNetQuantizationBounds();
+		Context.ServerTime = OwnerComponent->GetSyncedTime();
+	}
+
+	TGuardValue<const FIVSmokeHoleNetContext*> ContextGuard(GActiveHoleNetContext, &Context);
+	return FFastArraySerializer::FastArrayDeltaSerialize<FIVSmokeHoleData, FIVSmokeHoleArray>(
+		Items, DeltaParms, *this
+	);
+}
+
+void FIVSmokeHoleArray::AddHole(const FIVSmokeHoleData& NewHole)
+{
+	const int32 Index = Items.Add(NewHole);
+	MarkItemDirty(Items[Index]);
+
+	ItemIndices.Add(Items[Index].ReplicationID, Index);
+	ExpiryHeap.HeapPush({ NewHole.ExpirationServerTime, Items[Index].ReplicationID });
+}
+
+void FIVSmokeHoleArray::ReplaceEarliestExpiringHole(const FIVSmokeHoleData& NewHole)
+{
+	const int32 Index = GetEarliestExpiringIndex();
+	if (Index == INDEX_NONE)
+	{
+		AddHole(NewHole);
+		return;
+	}
+
+	FIVSmokeHoleData& Target = Items[Index];
+	Target.Position = NewHole.Position;
+	Target.EndPosition = NewHole.EndPosition;
+	Target.ExpirationServerTime = NewHole.ExpirationServerTime;
+	Target.PresetID = NewHole.PresetID;
+	MarkItemDirty(Target);
+
+	// ReplicationID is kept, so only the heap entry moves
+	ExpiryHeap.HeapPopDiscard();
+	ExpiryHeap.HeapPush({ Target.ExpirationServerTime, Target.ReplicationID });
+}
+
+int32 FIVSmokeHoleArray::RemoveExpiredHoles(const float CurrentServerTime)
+{
+	int32 NumRemoved = 0;
+	for (int32 Index = GetEarliestExpiringIndex(); Index != INDEX_NONE; Index = GetEarliestExpiringIndex())
+	{
+		if (!Items[Index].IsExpired(CurrentServerTime))
+		{
+			break;
+		}
+
+		ExpiryHeap.HeapPopDiscard();
+		RemoveAtSwap(Index);
+		++NumRemoved;
+	}
+	return NumRemoved;
+}
+
+void FIVSmokeHoleArray::RemoveAtSwap(const int32 Index)
+{
+	if (!Items.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	// The heap entry goes stale and is discarded lazily
+	ItemIndices.Remove(Items[Index].ReplicationID);
+	Items.RemoveAtSwap(Index);
+	if (Items.IsValidIndex(Index))
+	{
+		ItemIndices.Add(Items[Index].ReplicationID, Index);
+	}
+	MarkArrayDirty();
+}
+
+int32 FIVSmokeHoleArray::GetEarliestExpiringIndex()
+{
+	while (ExpiryHeap.Num() > 0)
+	{
+		const FExpiryEntry& Top = ExpiryHeap.HeapTop();
+		const int32* Index = ItemIndices.Find(Top.ReplicationID);
+		if (Index && Items[*Index].ExpirationServerTime == Top.ExpirationServerTime)
+		{
+			return *Index;
+		}
+		ExpiryHeap.HeapPopDiscard();
+	}
+	return INDEX_NONE;
+}
+
 void FIVSmokeHoleArray::Empty()
 {
 	Items.Empty();
+	ExpiryHeap.Empty();
+	ItemIndices.Empty();
 	MarkArrayDirty();
 }
 
-TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(const float CurrentServerTime) const
+TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(TArray<float>& OutCurveLUT) const
 {
 	TArray<FIVSmokeHoleGPU> GPUBuffer;
 	TArray<FIVSmokeHoleGPU> BulletBuffer;
@@ -46,6 +260,30 @@ TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(const float CurrentSer
 	DynamicObjectBuffer.Reserve(FMath::Max(Num(), 1));
 	GPUBuffer.Reserve(FMath::Max(Num(), 1));
 
+	// Each curve is sampled once, no matter how many holes share it
+	TMap<const UCurveFloat*, int32> CurveIndices;
+	auto FindOrAddCurveLUT = [&CurveIndices, &OutCurveLUT](const UCurveFloat* Curve) -> int32
+	{
+		if (!Curve)
+		{
+			return INDEX_NONE;
+		}
+
+		if (const int32* Found = CurveIndices.Find(Curve))
+		{
+			return *Found;
+		}
+
+		constexpr int32 LUTSize = FIVSmokeHoleCarveCS::CurveLUTSize;
+		const int32 CurveIndex = OutCurveLUT.Num() / LUTSize;
+		for (int32 i = 0; i < LUTSize; ++i)
+		{
+			OutCurveLUT.Add(Curve->GetFloatValue(static_cast<float>(i) / (LUTSize - 1)));
+		}
+		CurveIndices.Add(Curve, CurveIndex);
+		return CurveIndex;
+	};
+
 	for (const FIVSmokeHoleData& Hole : Items)
 	{
 		TObjectPtr<UIVSmokeHolePreset> Preset = UIVSmokeHolePreset::FindByID(Hole.PresetID);
@@ -54,7 +292,7 @@ TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(const float CurrentSer
 			continue;
 		}
 
-		FIVSmokeHoleGPU GPUHole = FIVSmokeHoleGPU(Hole, *Preset.Get(), CurrentServerTime);
+		FIVSmokeHoleGPU GPUHole = FIVSmokeHoleGPU(Hole, *Preset.Get());
 
 		if (Preset->HoleType == EIVSmokeHoleType::Penetration)
 		{
@@ -62,6 +300,8 @@ TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(const float CurrentSer
 		}
 		else if (Preset->HoleType == EIVSmokeHoleType::Explosion)
 		{
+			GPUHole.ExpansionCurveIndex = FindOrAddCurveLUT(Preset->ExpansionFadeRangeCurveOverTime);
+			GPUHole.ShrinkCurveIndex = FindOrAddCurveLUT(Preset->ShrinkFadeRangeCurveOverTime);
 			GrenadeBuffer.Add(GPUHole);
 		}
 		else if (Preset->HoleType == EIVSmokeHoleType::Dynamic)
@@ -70,26 +310,26 @@ TArray<FIVSmokeHoleGPU> FIVSmokeHoleArray::GetHoleGPUData(const float CurrentSer
 		}
 	}
 
+	// Explosions must come first: penetration holes read the explosion fade accumulated earlier in the carve loop
 	GPUBuffer.Append(GrenadeBuffer);
 	GPUBuffer.Append(BulletBuffer);
 	GPUBuffer.Append(DynamicObjectBuffer);
 
-	if (GPUBuffer.Num() == 0)
-	{
-		GPUBuffer.AddDefaulted(1);
-	}
-
 	return GPUBuffer;
 }
 
-FIVSmokeHoleGPU::FIVSmokeHoleGPU(const FIVSmokeHoleData& DynamicHoleData, const UIVSmokeHolePreset& Preset, const float CurrentServerTime)
+FIVSmokeHoleGPU::FIVSmokeHoleGPU(const FIVSmokeHoleData& DynamicHoleData, const UIVSmokeHolePreset& Preset)
 {
+	FMemory::Memzero(this, sizeof(FIVSmokeHoleGPU));
+
 	Position = FVector3f(DynamicHoleData.Position);
 	EndPosition = FVector3f(DynamicHoleData.EndPosition);
 
 	HoleType = static_cast<int32>(Preset.HoleType);
 	Radius = Preset.Radius;
 	Duration = Preset.Duration;
+	ExpansionCurveIndex = INDEX_NONE;
+	ShrinkCurveIndex = INDEX_NONE;
 	if (Duration == 0)
 	{
 		return;
@@ -97,24 +337,15 @@ FIVSmokeHoleGPU::FIVSmokeHoleGPU(const FIVSmokeHoleData& DynamicHoleData, const
 	Softness = Preset.Softness;
 	ExpansionDuration = Preset.ExpansionDuration;
 
-	//SetTime
-	float RemainingTime = DynamicHoleData.ExpirationServerTime - CurrentServerTime;
-	CurLifeTime = Duration - RemainingTime;
-	float NormalizedTime = FMath::Clamp(CurLifeTime / Duration, 0.0f, 1.0f);
+	// Lifetime is evaluated on the GPU: CurLifeTime = CurrentServerTime - SpawnServerTime
+	SpawnServerTime = DynamicHoleData.ExpirationServerTime - Duration;
 
 	switch (Preset.HoleType)
 	{
 	case EIVSmokeHoleType::Explosion:
-	{
-		float ExpansionNormalizedTime = FMath::Clamp(CurLifeTime / Preset.ExpansionDuration, 0.0f, 1.0f);
-		float ShrinkNormalizedTime = FMath::Clamp((CurLifeTime - Preset.ExpansionDuration) / (Preset.Duration - Preset.ExpansionDuration), 0.0f, 1.0f);
-
-		CurExpansionFadeRangeOverTime = Preset.ExpansionFadeRangeCurveOverTime ? UIVSmokeHolePreset::GetFloatValue(Preset.ExpansionFadeRangeCurveOverTime, ExpansionNormalizedTime) : ExpansionNormalizedTime;
-		CurShrinkFadeRangeOverTime = Preset.ShrinkFadeRangeCurveOverTime ? UIVSmokeHolePreset::GetFloatValue(Preset.ShrinkFadeRangeCurveOverTime, ShrinkNormalizedTime) : 1 - ShrinkNormalizedTime;
 		DistortionExpOverTime = Preset.DistortionExpOverTime;
 		DistortionDistance = Preset.DistortionDistance;
 		break;
-	}
 	case EIVSmokeHoleType::Penetration:
 		EndRadius = Preset.EndRadius;
 		break;
@@ -2,15 +2,17 @@
 
 #include "IVSmokeHoleGeneratorComponent.h"
 
-#include "Engine/TextureRenderTargetVolume.h"
 #include "Engine/Texture2D.h"
 #include "Engine/World.h"
 #include "GameFramework/GameStateBase.h"
 #include "GlobalShader.h"
 #include "IVSmoke.h"
+#include "IVSmokeHoleAtlas.h"
 #include "IVSmokeHoleShaders.h"
 #include "IVSmokeHolePreset.h"
+#include "IVSmokeHoleTrackerSubsystem.h"
 #include "IVSmokePostProcessPass.h"
+#include "IVSmokeSettings.h"
 #include "IVSmokeVoxelVolume.h"
 #include "Net/UnrealNetwork.h"
 #include "RHICommandList.h"
@@ -20,8 +22,29 @@
 #include "RenderingThread.h"
 #include "TextureResource.h"
 
+namespace
+{
+	/** Pixel format of the hole atlas for the configured hole texture format. */
+	EPixelFormat GetHoleMaskFormat()
+	{
+		const UIVSmokeSettings* Settings = UIVSmokeSettings::Get();
+		switch (Settings ? Settings->HoleTextureFormat : EIVSmokeHoleTextureFormat::Full)
+		{
+		case EIVSmokeHoleTextureFormat::CompactR16:
+			return PF_G16;
+		case EIVSmokeHoleTextureFormat::CompactR8:
+			return PF_G8;
+		case EIVSmokeHoleTextureFormat::Full:
+		default:
+			return PF_FloatRGBA;
+		}
+	}
+}
+
 UIVSmokeHoleGeneratorComponent::UIVSmokeHoleGeneratorComponent()
 	: bHoleTextureDirty(false)
+	, bHoleBufferDirty(false)
+	, bHoleDensityQueryDirty(true)
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	SetIsReplicatedByDefault(true);
@@ -45,26 +68,30 @@ void UIVSmokeHoleGeneratorComponent::BeginPlay()
 	ActiveHoles.OwnerComponent = this;
 	ActiveHoles.Reserve(MaxHoles);
 
-	// Join process
-	if (ActiveHoles.Num() > 0)
+	// 2. Dynamic subjects are routed to this component by the world tracker
+	if (GetOwner()->HasAuthority())
 	{
-		MarkHoleTextureDirty();
+		if (UIVSmokeHoleTrackerSubsystem* Tracker = UIVSmokeHoleTrackerSubsystem::Get(GetWorld()))
+		{
+			Tracker->RegisterGenerator(this);
+		}
 	}
 
-#if !UE_SERVER
-	Local_InitializeHoleTexture();
-#endif
+	// Join process. The hole atlas slot is allocated by the first rebuild.
+	if (ActiveHoles.Num() > 0)
+	{
+		MarkHoleBufferDirty();
+	}
 }
 
 void UIVSmokeHoleGeneratorComponent::TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// 1. Server cleans up expired holes and updates dynamic objects
+	// 1. Server cleans up expired holes. Dynamic objects are updated by UIVSmokeHoleTrackerSubsystem.
 	if (GetOwner()->HasAuthority())
 	{
 		Authority_CleanupExpiredHoles();
-		Authority_UpdateDynamicSubjectList();
 	}
 
 	// 2. All host update voxel volume area
@@ -76,17 +103,18 @@ void UIVSmokeHoleGeneratorComponent::TickComponent(const float DeltaTime, const
 		MarkHoleTextureDirty();
 	}
 
-	// 4. Client & Standalone rebuild texture
+	// 4. Client & Standalone rebuild texture. The atlas slot only exists while holes do.
 #if !UE_SERVER
 	if (bHoleTextureDirty)
 	{
 		if (ActiveHoles.Num() > 0)
 		{
+			Local_AllocateHoleAtlasSlot();
 			Local_RebuildHoleTexture();
 		}
 		else
 		{
-			Local_ClearHoleTexture();
+			Local_FreeHoleAtlasSlot();
 		}
 		MarkHoleTextureDirty(false);
 	}
@@ -95,6 +123,27 @@ void UIVSmokeHoleGeneratorComponent::TickComponent(const float DeltaTime, const
 
 void UIVSmokeHoleGeneratorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	if (UIVSmokeHoleTrackerSubsystem* Tracker = UIVSmokeHoleTrackerSubsystem::Get(GetWorld()))
+	{
+		Tracker->UnregisterGenerator(this);
+	}
+
+#if !UE_SERVER
+	// Hand the atlas slot back cleared
+	Local_FreeHoleAtlasSlot();
+
+	// Release pooled buffers on the render thread
+	if (HoleGPUResources.IsValid())
+	{
+		ENQUEUE_RENDER_COMMAND(IVSmokeHoleReleaseBuffers)(
+			[Resources = MoveTemp(HoleGPUResources)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				Resources.Reset();
+			}
+		);
+	}
+#endif
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -113,14 +162,19 @@ void UIVSmokeHoleGeneratorComponent::Reset()
 	ActiveHoles.Empty();
 
 	// 2. Clear all dynamic subjects
-	DynamicSubjectList.Empty();
+	if (UIVSmokeHoleTrackerSubsystem* Tracker = UIVSmokeHoleTrackerSubsystem::Get(GetWorld()))
+	{
+		Tracker->UnregisterSubjects(this);
+	}
 
-	// 3. Clear hole texture
+	// 3. Free hole atlas slot
 #if !UE_SERVER
-	Local_ClearHoleTexture();
+	Local_FreeHoleAtlasSlot();
 #endif
 
 	MarkHoleTextureDirty(false);
+	bHoleBufferDirty = true;
+	bHoleDensityQueryDirty = true;
 }
 #pragma endregion
 
@@ -164,6 +218,64 @@ void UIVSmokeHoleGeneratorComponent::CreatePenetrationHole(const FVector3f& InOr
 	Authority_CreateHole(HoleData);
 }
 
+void UIVSmokeHoleGeneratorComponent::CreatePenetrationHoles(TConstArrayView<FIVSmokePenetrationRequest> Requests)
+{
+	struct FAcceptedHit
+	{
+		FIVSmokeHoleData HoleData;
+		FVector3f SmokeExit;
+	};
+
+	// 1. Shared per batch
+	const float CurrentTime = GetSyncedTime();
+
+	TArray<FAcceptedHit, TInlineAllocator<16>> AcceptedHits;
+	for (const FIVSmokePenetrationRequest& Request : Requests)
+	{
+		const UIVSmokeHolePreset* Preset = Request.Preset;
+		if (!Preset || Preset->HoleType != EIVSmokeHoleType::Penetration || Preset->Duration <= 0.0f)
+		{
+			UE_LOG(LogIVSmoke, Warning, TEXT("[CreatePenetrationHoles] Invalid penetration preset"));
+			continue;
+		}
+
+		FVector3f EntryPoint, ExitPoint;
+		if (!Authority_ClipRayToSmoke(Request.Origin, Request.Direction, EntryPoint, ExitPoint))
+		{
+			continue;
+		}
+
+		// 2. Coalesce hits that would carve the same tunnel
+		const uint8 PresetID = Preset->GetPresetID();
+		const float CoalesceDistanceSquared = FMath::Square(Preset->BulletThickness);
+		const bool bCoalesced = AcceptedHits.ContainsByPredicate([&](const FAcceptedHit& Hit)
+		{
+			return Hit.HoleData.PresetID == PresetID
+				&& FVector3f::DistSquared(Hit.HoleData.Position, EntryPoint) <= CoalesceDistanceSquared
+				&& FVector3f::DistSquared(Hit.SmokeExit, ExitPoint) <= CoalesceDistanceSquared;
+		});
+		if (bCoalesced)
+		{
+			continue;
+		}
+
+		// 3. Obstacle sweep only for surviving hits
+		FAcceptedHit& Hit = AcceptedHits.AddDefaulted_GetRef();
+		Hit.SmokeExit = ExitPoint;
+		Authority_ClipPenetrationByObstacles(EntryPoint, Preset->BulletThickness, ExitPoint);
+
+		Hit.HoleData.Position = EntryPoint;
+		Hit.HoleData.EndPosition = ExitPoint;
+		Hit.HoleData.PresetID = PresetID;
+		Hit.HoleData.ExpirationServerTime = CurrentTime + Preset->Duration;
+	}
+
+	for (const FAcceptedHit& Hit : AcceptedHits)
+	{
+		Authority_CreateHole(Hit.HoleData);
+	}
+}
+
 void UIVSmokeHoleGeneratorComponent::CreateExplosionHole(const FVector3f& Origin, const uint8 PresetID)
 {
 	const TObjectPtr<UIVSmokeHolePreset> Preset = UIVSmokeHolePreset::FindByID(PresetID);
@@ -224,23 +336,43 @@ void UIVSmokeHoleGeneratorComponent::RegisterTrackDynamicHole(AActor* TargetActo
 		return;
 	}
 
-	// 1. Check if already registered
-	for (const FIVSmokeHoleDynamicSubject& Tracker : DynamicSubjectList)
+	// 1. Register with the world tracker, which polls the actor once per tick for every volume
+	if (UIVSmokeHoleTrackerSubsystem* Tracker = UIVSmokeHoleTrackerSubsystem::Get(GetWorld()))
 	{
-		if (Tracker.TargetActor == TargetActor)
-		{
-			UE_LOG(LogIVSmoke, Warning, TEXT("[RegisterTrackDynamicHole] Actor already registered"));
-			return;
-		}
+		Tracker->RegisterSubject(TargetActor, Preset, this);
 	}
+}
 
-	// 2. Register new subject
-	FIVSmokeHoleDynamicSubject NewDynamicSubject;
-	NewDynamicSubject.TargetActor = TargetActor;
-	NewDynamicSubject.PresetID = PresetID;
-	NewDynamicSubject.LastWorldPosition = FVector3f(TargetActor->GetActorLocation());
-	NewDynamicSubject.LastWorldRotation = TargetActor->GetActorQuat();
-	DynamicSubjectList.Add(NewDynamicSubject);
+void UIVSmokeHoleGeneratorComponent::CreateDynamicHoles(TConstArrayView<FIVSmokeHoleData> Holes)
+{
+	for (const FIVSmokeHoleData& HoleData : Holes)
+	{
+		Authority_CreateHole(HoleData);
+	}
+}
+
+float UIVSmokeHoleGeneratorComponent::GetHoleDensityAt(const FVector& WorldPosition) const
+{
+	const AIVSmokeVoxelVolume* VoxelVolume = Cast<AIVSmokeVoxelVolume>(GetOwner());
+	if (VoxelVolume == nullptr || ActiveHoles.Num() == 0)
+	{
+		return 1.0f;
+	}
+
+	// Hole data carries no time dependent values, the carve only changes with the hole list or the volume bounds
+	const FVector3f VolumeMin(VoxelVolume->GetVoxelWorldAABBMin());
+	const FVector3f VolumeMax(VoxelVolume->GetVoxelWorldAABBMax());
+	if (bHoleDensityQueryDirty || VolumeMin != HoleDensityQueryMin || VolumeMax != HoleDensityQueryMax)
+	{
+		TArray<float> CurveLUT;
+		TArray<FIVSmokeHoleGPU> GPUHoles = ActiveHoles.GetHoleGPUData(CurveLUT);
+		HoleDensityQuery = FIVSmokeHoleCarveCPU(MoveTemp(GPUHoles), MoveTemp(CurveLUT), VolumeMin, VolumeMax);
+		HoleDensityQueryMin = VolumeMin;
+		HoleDensityQueryMax = VolumeMax;
+		bHoleDensityQueryDirty = false;
+	}
+
+	return HoleDensityQuery.Evaluate(FVector3f(WorldPosition), GetSyncedTime()).W;
 }
 #pragma endregion
 
@@ -255,162 +387,106 @@ void UIVSmokeHoleGeneratorComponent::Authority_CreateHole(const FIVSmokeHoleData
 	}
 	else
 	{
-		int32 OldestIndex = 0;
-		float MinTime = FLT_MAX;
-
-		for (int32 i = 0; i < ActiveHoles.Num(); ++i)
-		{
-			if (ActiveHoles[i].ExpirationServerTime < MinTime)
-			{
-				MinTime = ActiveHoles[i].ExpirationServerTime;
-				OldestIndex = i;
-			}
-		}
-
-		FIVSmokeHoleData& Target = ActiveHoles[OldestIndex];
-		Target.Position = HoleData.Position;
-		Target.EndPosition = HoleData.EndPosition;
-		Target.ExpirationServerTime = HoleData.ExpirationServerTime;
-		Target.PresetID = HoleData.PresetID;
-		ActiveHoles.MarkItemDirty(Target);
+		// Evict the hole closest to expiring
+		ActiveHoles.ReplaceEarliestExpiringHole(HoleData);
 	}
 
-	MarkHoleTextureDirty();
+	MarkHoleBufferDirty();
 }
 
 void UIVSmokeHoleGeneratorComponent::Authority_CleanupExpiredHoles()
 {
-	const float CurrentServerTime = GetSyncedTime();
-
-	for (int32 i = ActiveHoles.Num() - 1; i >= 0; --i)
+	// Only holes that are due are visited
+	if (ActiveHoles.RemoveExpiredHoles(GetSyncedTime()) > 0)
 	{
-		if (ActiveHoles[i].IsExpired(CurrentServerTime))
-		{
-			ActiveHoles.RemoveAtSwap(i);
-			MarkHoleTextureDirty();
-		}
+		MarkHoleBufferDirty();
 	}
 }
 
 bool UIVSmokeHoleGeneratorComponent::Authority_CalculatePenetrationPoints(
 	const FVector3f& Origin, const FVector3f& Direction, const float BulletThickness, FVector3f& OutEntry, FVector3f& OutExit)
 {
-	FVector3f NormalizedDirection = Direction.GetSafeNormal();
-	if (NormalizedDirection.IsNearlyZero())
+	if (Direction.IsNearlyZero())
 	{
 		UE_LOG(LogIVSmoke, Warning, TEXT("[CalculatePenetrationPoints] Direction is zero"));
 		return false;
 	}
 
-	const float DistToCenter = FVector3f::Dist(Origin, FVector3f(GetComponentLocation()));
-	const float DiagonalLength = GetScaledBoxExtent().Size() * 2.0f;
-	const float MaxDistance = DistToCenter + DiagonalLength;
+	// 1. Entry & exit where the ray actually crosses smoke
+	if (!Authority_ClipRayToSmoke(Origin, Direction, OutEntry, OutExit))
+	{
+		return false;
+	}
 
-	const FVector3f RayEnd = Origin + NormalizedDirection * MaxDistance;
+	// 2. Obstacle detection using SphereTrace between Entry and Exit
+	Authority_ClipPenetrationByObstacles(OutEntry, BulletThickness, OutExit);
 
-	FHitResult HitEntry, HitExit;
-	FCollisionQueryParams QueryParams;
-	QueryParams.bTraceComplex = false;
+	return true;
+}
 
-	// 1. Forward trace (Origin -> RayEnd) to find Entry point
-	if (!LineTraceComponent(HitEntry, FVector(Origin), FVector(RayEnd), QueryParams))
+bool UIVSmokeHoleGeneratorComponent::Authority_ClipRayToSmoke(const FVector3f& Origin, const FVector3f& Direction, FVector3f& OutEntry, FVector3f& OutExit) const
+{
+	const FVector RayOrigin(Origin);
+	const FVector RayDirection = FVector(Direction).GetSafeNormal();
+	if (RayDirection.IsNearlyZero())
 	{
 		return false;
 	}
 
-	// 2. Reverse trace (RayEnd -> Origin) to find Exit point
-	if (!LineTraceComponent(HitExit, FVector(RayEnd), FVector(Origin), QueryParams))
+	double TNear, TFar;
+	if (const TObjectPtr<AIVSmokeVoxelVolume> VoxelVolume = Cast<AIVSmokeVoxelVolume>(GetOwner()))
 	{
-		OutExit = FVector3f(HitEntry.Location);
+		// Slab test against the voxel AABB, refined by a DDA over the active voxels
+		if (!VoxelVolume->TraceActiveVoxelSpan(RayOrigin, RayDirection, TNear, TFar))
+		{
+			return false;
+		}
 	}
 	else
 	{
-		OutExit = FVector3f(HitExit.Location);
-	}
-
-	OutEntry = FVector3f(HitEntry.Location);
-
-	// 3. Obstacle detection using SphereTrace between Entry and Exit
-	if (ObstacleObjectTypes.Num() > 0)
-	{
-		TArray<FHitResult> HitResults;
-		FCollisionQueryParams WorldParams;
-		WorldParams.AddIgnoredComponent(this);
-		const FCollisionShape SweepShape = FCollisionShape::MakeSphere(BulletThickness);
-		const FCollisionObjectQueryParams ObjectParams(ObstacleObjectTypes);
-
-		if (GetWorld()->SweepMultiByObjectType(
-			HitResults, FVector(OutEntry), FVector(OutExit), FQuat::Identity,
-			ObjectParams, SweepShape, WorldParams))
+		// No voxel data, slab test against the box in its local space. The transform is affine, so T stays in world units.
+		const FTransform& BoxTransform = GetComponentTransform();
+		const FVector BoxExtent = GetUnscaledBoxExtent();
+		if (!UIVSmokeGridLibrary::RayBoxIntersection(-BoxExtent, BoxExtent,
+			BoxTransform.InverseTransformPosition(RayOrigin), BoxTransform.InverseTransformVector(RayDirection), TNear, TFar))
 		{
-			for (const FHitResult& Hit : HitResults)
-			{
-				if (AActor* HitActor = Hit.GetActor())
-				{
-					if (!HitActor->ActorHasTag(IVSmokeVoxelVolumeTag))
-					{
-						OutExit = FVector3f(Hit.Location);
-						break;
-					}
-				}
-			}
+			return false;
 		}
 	}
 
+	OutEntry = FVector3f(RayOrigin + RayDirection * TNear);
+	OutExit = FVector3f(RayOrigin + RayDirection * TFar);
 	return true;
 }
 
-void UIVSmokeHoleGeneratorComponent::Authority_UpdateDynamicSubjectList()
+void UIVSmokeHoleGeneratorComponent::Authority_ClipPenetrationByObstacles(const FVector3f& Entry, const float BulletThickness, FVector3f& InOutExit) const
 {
-	const float CurrentTime = GetSyncedTime();
-	const FBox3f SmokeVolume = FBox3f(Bounds.GetBox());
-
-	for (int32 i = DynamicSubjectList.Num() - 1; i >= 0; --i)
+	if (ObstacleObjectTypes.Num() == 0)
 	{
-		FIVSmokeHoleDynamicSubject& DynamicSubject = DynamicSubjectList[i];
-
-		// 0. Delete if object is not alive
-		if (!DynamicSubject.TargetActor.IsValid())
-		{
-			DynamicSubjectList.RemoveAtSwap(i);
-			continue;
-		}
-
-		const TObjectPtr<AActor> Actor = DynamicSubject.TargetActor.Get();
-		const TObjectPtr<UIVSmokeHolePreset> Preset = UIVSmokeHolePreset::FindByID(DynamicSubject.PresetID);
-
-		// 0. Delete if preset is not valid
-		if (!Preset)
-		{
-			DynamicSubjectList.RemoveAtSwap(i);
-			continue;
-		}
-
-		const FVector3f CurrentPos = FVector3f(Actor->GetActorLocation());
-		const FVector3f LastPos = FVector3f(DynamicSubject.LastWorldPosition);
+		return;
+	}
 
-		if (!SmokeVolume.IsInside(CurrentPos))
-		{
-			continue;
-		}
+	TArray<FHitResult> HitResults;
+	FCollisionQueryParams WorldParams;
+	WorldParams.AddIgnoredComponent(this);
+	const FCollisionShape SweepShape = FCollisionShape::MakeSphere(BulletThickness);
+	const FCollisionObjectQueryParams ObjectParams(ObstacleObjectTypes);
 
-		// 1. Ignore if object moves a little bit
-		if (Preset->DistanceThreshold > FVector3f::Dist(CurrentPos, LastPos))
+	if (GetWorld()->SweepMultiByObjectType(
+		HitResults, FVector(Entry), FVector(InOutExit), FQuat::Identity,
+		ObjectParams, SweepShape, WorldParams))
+	{
+		for (const FHitResult& Hit : HitResults)
 		{
-			continue;
+			if (AActor* HitActor = Hit.GetActor())
+			{
+				if (!HitActor->ActorHasTag(IVSmokeVoxelVolumeTag))
+				{
+					InOutExit = FVector3f(Hit.Location);
+					break;
+				}
+			}
 		}
-
-		// 2. Create Hole
-		FIVSmokeHoleData HoleData;
-		HoleData.Position = LastPos;
-		HoleData.EndPosition = CurrentPos;
-		HoleData.PresetID = DynamicSubject.PresetID;
-		HoleData.ExpirationServerTime = CurrentTime + Preset->Duration;
-		Authority_CreateHole(HoleData);
-
-		// 3. Update registered object
-		DynamicSubject.LastWorldPosition = CurrentPos;
-		DynamicSubject.LastWorldRotation = Actor->GetActorQuat();
 	}
 }
 #pragma endregion
@@ -419,99 +495,151 @@ void UIVSmokeHoleGeneratorComponent::Authority_UpdateDynamicSubjectList()
 // Local Only
 #pragma region Local Only
 #if !UE_SERVER
-void UIVSmokeHoleGeneratorComponent::Local_InitializeHoleTexture()
+void UIVSmokeHoleGeneratorComponent::Local_AllocateHoleAtlasSlot()
 {
 	if (VoxelResolution.X <= 0 || VoxelResolution.Y <= 0 || VoxelResolution.Z <= 0)
 	{
 		return;
 	}
 
-	// Create UTextureRenderTargetVolume
-	HoleTexture = NewObject<UTextureRenderTargetVolume>(this, TEXT("HoleTexture"));
-	HoleTexture->Init(VoxelResolution.X, VoxelResolution.Y, VoxelResolution.Z, PF_FloatRGBA);
-	HoleTexture->bCanCreateUAV = true;
-	HoleTexture->ClearColor = FLinearColor::White;
-	HoleTexture->SRGB = false;
-	HoleTexture->UpdateResourceImmediate(true);
-}
-
-void UIVSmokeHoleGeneratorComponent::Local_ClearHoleTexture()
-{
-	if (!HoleTexture)
+	if (HoleAtlasSlot != INDEX_NONE)
 	{
 		return;
 	}
 
-	FTextureRenderTargetResource* RenderTargetResource = HoleTexture->GameThread_GetRenderTargetResource();
-	if (!RenderTargetResource)
+	HoleAtlasSlot = FIVSmokeHoleAtlas::Get().AllocateSlot(VoxelResolution, GetHoleMaskFormat());
+	if (HoleAtlasSlot == INDEX_NONE)
 	{
+		if (!bHoleAtlasFullWarned)
+		{
+			bHoleAtlasFullWarned = true;
+			UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleGeneratorComponent::Local_AllocateHoleAtlasSlot] No hole atlas slot for %s (resolution %s). Its holes are not rendered."),
+				*GetNameSafe(GetOwner()), *VoxelResolution.ToString());
+		}
 		return;
 	}
+	bHoleAtlasFullWarned = false;
 
-	FTextureRHIRef Texture = RenderTargetResource->GetRenderTargetTexture();
-	if (!Texture.IsValid())
+	if (!HoleGPUResources.IsValid())
 	{
-		return;
+		HoleGPUResources = MakeShared<FIVSmokeHoleGPUResources, ESPMode::ThreadSafe>();
 	}
 
-	ENQUEUE_RENDER_COMMAND(IVSmokeHoleClear)(
-		[Texture](FRHICommandListImmediate& RHICmdList)
-		{
-			FRDGBuilder GraphBuilder(RHICmdList);
-
-			const FRDGTextureRef RDGTexture = GraphBuilder.RegisterExternalTexture(
-				CreateRenderTarget(Texture, TEXT("IVSmokeHoleTextureClear"))
-			);
-
-			// Clear to white (1,1,1,1) = no holes = full smoke density
-			AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(RDGTexture), FVector4f(1.0f, 1.0f, 1.0f, 1.0f));
+	// A new slot carries no distortion yet, re-evaluate it with the hole list
+	bHoleAtlasDistortion = false;
+	MarkHoleBufferDirty();
+}
 
-			GraphBuilder.Execute();
-		}
-	);
+void UIVSmokeHoleGeneratorComponent::Local_FreeHoleAtlasSlot()
+{
+	// Freeing clears the slot and drops its distortion
+	FIVSmokeHoleAtlas::Get().FreeSlot(HoleAtlasSlot);
+	HoleAtlasSlot = INDEX_NONE;
+	bHoleAtlasDistortion = false;
 }
 
 void UIVSmokeHoleGeneratorComponent::Local_RebuildHoleTexture()
 {
-	if (!HoleTexture)
+	if (HoleAtlasSlot == INDEX_NONE)
 	{
 		return;
 	}
 
-	if (HoleTexture->SizeX != VoxelResolution.X ||
-		HoleTexture->SizeY != VoxelResolution.Y ||
-		HoleTexture->SizeZ != VoxelResolution.Z)
+	const TObjectPtr<AIVSmokeVoxelVolume> VoxelVolume = Cast<AIVSmokeVoxelVolume>(GetOwner());
+	if (VoxelVolume == nullptr || !HoleGPUResources.IsValid())
 	{
-		Local_InitializeHoleTexture();
 		return;
 	}
 
-	const FTextureRenderTargetResource* RenderTargetResource = HoleTexture->GameThread_GetRenderTargetResource();
-	if (!RenderTargetResource)
+	// The hole texture format can be switched in project settings at runtime
+	FIVSmokeHoleAtlas& HoleAtlas = FIVSmokeHoleAtlas::Get();
+	if (HoleAtlas.GetLayout().Format != GetHoleMaskFormat())
 	{
-		return;
+		HoleAtlas.SetFormat(GetHoleMaskFormat());
 	}
 
-	TArray<FIVSmokeHoleGPU> GPUHoles = ActiveHoles.GetHoleGPUData(GetSyncedTime());
+	// All slots share the largest requested resolution
+	const FIVSmokeHoleAtlasLayout& AtlasLayout = HoleAtlas.GetLayout();
+	const FIntVector Resolution = AtlasLayout.SlotResolution;
 
-	const TObjectPtr<AIVSmokeVoxelVolume> VoxelVolume = Cast<AIVSmokeVoxelVolume>(GetOwner());
-	if (VoxelVolume == nullptr)
+	// Hole buffers are time-independent: rebuild and upload only when the hole list changed
+	const bool bUploadHoleBuffer = bHoleBufferDirty;
+	if (bUploadHoleBuffer)
 	{
-		return;
-	}
+		BinnedCurveLUT.Reset();
+		BinnedGPUHoles = ActiveHoles.GetHoleGPUData(BinnedCurveLUT);
+		bHoleBufferDirty = false;
 
-	FTextureRHIRef Texture = RenderTargetResource->GetRenderTargetTexture();
-	if (!Texture.IsValid())
-	{
-		return;
+		// Compact formats keep distortion in a separate atlas that only exists while explosions are active
+		bool bHasExplosion = false;
+		HoleDistortionRange = 0.0f;
+		for (const FIVSmokeHoleGPU& Hole : BinnedGPUHoles)
+		{
+			if (Hole.HoleType == static_cast<int32>(EIVSmokeHoleType::Explosion))
+			{
+				bHasExplosion = true;
+				HoleDistortionRange = FMath::Max(HoleDistortionRange, Hole.DistortionDistance);
+			}
+		}
+		if (bHasExplosion != bHoleAtlasDistortion)
+		{
+			HoleAtlas.SetSlotDistortion(HoleAtlasSlot, bHasExplosion);
+			bHoleAtlasDistortion = bHasExplosion;
+		}
 	}
 
+	// Bricks are laid out over the voxel AABB, so re-bin when the holes, the bounds or the slot resolution change
 	const FVector3f WorldVolumeMin = FVector3f(VoxelVolume->GetVoxelWorldAABBMin());
 	const FVector3f WorldVolumeMax = FVector3f(VoxelVolume->GetVoxelWorldAABBMax());
-	const FIntVector Resolution = VoxelResolution;
-	const int32 NumHoles = ActiveHoles.Num();
+	const bool bUploadBrickBins = bUploadHoleBuffer || WorldVolumeMin != BinnedVolumeMin || WorldVolumeMax != BinnedVolumeMax
+		|| Resolution != BinnedResolution;
+	FIVSmokeHoleBrickBins BrickBins;
+	int32 UploadNumActiveBricks = 0;
+	if (bUploadBrickBins)
+	{
+		BrickBins.Build(BinnedGPUHoles, BinnedCurveLUT, WorldVolumeMin, WorldVolumeMax, Resolution);
+		BinnedVolumeMin = WorldVolumeMin;
+		BinnedVolumeMax = WorldVolumeMax;
+		BinnedResolution = Resolution;
+		UploadNumActiveBricks = BrickBins.ActiveBricks.Num();
+
+		// Structured buffers cannot be empty
+		if (BrickBins.BrickHoleIndices.Num() == 0)
+		{
+			BrickBins.BrickHoleIndices.AddZeroed(1);
+		}
+		if (BrickBins.ActiveBricks.Num() == 0)
+		{
+			BrickBins.ActiveBricks.AddZeroed(1);
+		}
+	}
+
+	TArray<FIVSmokeHoleGPU> GPUHoles;
+	TArray<float> CurveLUT;
+	if (bUploadHoleBuffer)
+	{
+		GPUHoles = BinnedGPUHoles;
+		CurveLUT = BinnedCurveLUT;
+
+		// Structured buffers cannot be empty
+		if (GPUHoles.Num() == 0)
+		{
+			GPUHoles.AddZeroed(1);
+		}
+		if (CurveLUT.Num() == 0)
+		{
+			CurveLUT.AddZeroed(1);
+		}
+	}
+
+	const float CurrentServerTime = GetSyncedTime();
 	const int32 CapturedBlurStep = BlurStep;
 
+	// Holes are carved into a transient RGBA16F volume and written into the atlas slot at the end
+	const int32 Slot = HoleAtlasSlot;
+	const bool bWriteDistortion = AtlasLayout.IsCompact() && bHoleAtlasDistortion;
+	const float CapturedDistortionRange = HoleDistortionRange;
+
 	// Capture noise settings for render thread
 	FTextureRHIRef PenetrationNoiseTextureRHI = PenetrationNoise.Texture && PenetrationNoise.Texture->GetResource()
 		? PenetrationNoise.Texture->GetResource()->TextureRHI : nullptr;
@@ -528,38 +656,134 @@ void UIVSmokeHoleGeneratorComponent::Local_RebuildHoleTexture()
 	const float CapturedDynamicNoiseScale = DynamicNoise.Scale;
 
 	ENQUEUE_RENDER_COMMAND(IVSmokeHoleCarveFullRebuild)(
-		[Texture, GPUHoles = MoveTemp(GPUHoles), WorldVolumeMin, WorldVolumeMax, Resolution, NumHoles, CapturedBlurStep,
+		[Slot, Resources = HoleGPUResources, bUploadHoleBuffer, GPUHoles = MoveTemp(GPUHoles), CurveLUT = MoveTemp(CurveLUT),
+		 bUploadBrickBins, BrickBins = MoveTemp(BrickBins), UploadNumActiveBricks,
+		 WorldVolumeMin, WorldVolumeMax, Resolution, CurrentServerTime, CapturedBlurStep,
+		 bWriteDistortion, CapturedDistortionRange,
 		 PenetrationNoiseTextureRHI, ExplosionNoiseTextureRHI, DynamicNoiseTextureRHI,
 		 CapturedPenetrationNoiseStrength, CapturedPenetrationNoiseScale,
 		 CapturedExplosionNoiseStrength, CapturedExplosionNoiseScale,
 		 CapturedDynamicNoiseStrength, CapturedDynamicNoiseScale]
 		(FRHICommandListImmediate& RHICmdList)
 		{
+			if (!bUploadHoleBuffer && !Resources->HoleBuffer.IsValid())
+			{
+				return;
+			}
+
 			FRDGBuilder GraphBuilder(RHICmdList);
 
-			const FRDGTextureRef RDGTexture = GraphBuilder.RegisterExternalTexture(
-				CreateRenderTarget(Texture, TEXT("IVSmokeHoleTexture"))
-			);
+			// The game thread cleared its dirty flags when queueing, so buffers are uploaded even if the carve is skipped below
+			FRDGBufferRef HoleBuffer = nullptr;
+			FRDGBufferRef CurveLUTBuffer = nullptr;
+			if (bUploadHoleBuffer)
+			{
+				HoleBuffer = CreateStructuredBuffer(
+					GraphBuilder,
+					TEXT("IVSmokeHoleBuffer"),
+					sizeof(FIVSmokeHoleGPU),
+					GPUHoles.Num(),
+					GPUHoles.GetData(),
+					sizeof(FIVSmokeHoleGPU) * GPUHoles.Num()
+				);
+				CurveLUTBuffer = CreateStructuredBuffer(
+					GraphBuilder,
+					TEXT("IVSmokeHoleCurveLUTBuffer"),
+					sizeof(float),
+					CurveLUT.Num(),
+					CurveLUT.GetData(),
+					sizeof(float) * CurveLUT.Num()
+				);
+				Resources->HoleBuffer = ConvertToExternalBuffer(GraphBuilder, HoleBuffer);
+				Resources->CurveLUTBuffer = ConvertToExternalBuffer(GraphBuilder, CurveLUTBuffer);
+			}
+			else
+			{
+				HoleBuffer = GraphBuilder.RegisterExternalBuffer(Resources->HoleBuffer);
+				CurveLUTBuffer = GraphBuilder.RegisterExternalBuffer(Resources->CurveLUTBuffer);
+			}
+
+			FRDGBufferRef BrickRangeBuffer = nullptr;
+			FRDGBufferRef BrickHoleIndexBuffer = nullptr;
+			FRDGBufferRef ActiveBrickBuffer = nullptr;
+			if (bUploadBrickBins)
+			{
+				BrickRangeBuffer = CreateStructuredBuffer(
+					GraphBuilder,
+					TEXT("IVSmokeHoleBrickRangeBuffer"),
+					sizeof(FUintVector2),
+					BrickBins.BrickRanges.Num(),
+					BrickBins.BrickRanges.GetData(),
+					sizeof(FUintVector2) * BrickBins.BrickRanges.Num()
+				);
+				BrickHoleIndexBuffer = CreateStructuredBuffer(
+					GraphBuilder,
+					TEXT("IVSmokeHoleBrickIndexBuffer"),
+					sizeof(uint32),
+					BrickBins.BrickHoleIndices.Num(),
+					BrickBins.BrickHoleIndices.GetData(),
+					sizeof(uint32) * BrickBins.BrickHoleIndices.Num()
+				);
+				ActiveBrickBuffer = CreateStructuredBuffer(
+					GraphBuilder,
+					TEXT("IVSmokeHoleActiveBrickBuffer"),
+					sizeof(uint32),
+					BrickBins.ActiveBricks.Num(),
+					BrickBins.ActiveBricks.GetData(),
+					sizeof(uint32) * BrickBins.ActiveBricks.Num()
+				);
+				Resources->BrickRangeBuffer = ConvertToExternalBuffer(GraphBuilder, BrickRangeBuffer);
+				Resources->BrickHoleIndexBuffer = ConvertToExternalBuffer(GraphBuilder, BrickHoleIndexBuffer);
+				Resources->ActiveBrickBuffer = ConvertToExternalBuffer(GraphBuilder, ActiveBrickBuffer);
+				Resources->BrickCount = BrickBins.BrickCount;
+				Resources->NumActiveBricks = UploadNumActiveBricks;
+			}
+			else
+			{
+				BrickRangeBuffer = GraphBuilder.RegisterExternalBuffer(Resources->BrickRangeBuffer);
+				BrickHoleIndexBuffer = GraphBuilder.RegisterExternalBuffer(Resources->BrickHoleIndexBuffer);
+				ActiveBrickBuffer = GraphBuilder.RegisterExternalBuffer(Resources->ActiveBrickBuffer);
+			}
+
+			// Skip carves queued against a previous atlas layout, the next tick re-carves from the uploaded buffers
+			FIVSmokeHoleAtlas& HoleAtlas = FIVSmokeHoleAtlas::Get();
+			const FIVSmokeHoleAtlasLayout& AtlasLayout = HoleAtlas.GetLayout_RenderThread();
+			if (AtlasLayout.SlotResolution != Resolution || Slot >= AtlasLayout.GetCapacity())
+			{
+				GraphBuilder.Execute();
+				return;
+			}
 
-			const FRDGBufferRef HoleBuffer = CreateStructuredBuffer(
-				GraphBuilder,
-				TEXT("IVSmokeHoleBuffer"),
-				sizeof(FIVSmokeHoleGPU),
-				GPUHoles.Num(),
-				GPUHoles.GetData(),
-				sizeof(FIVSmokeHoleGPU) * GPUHoles.Num()
+			const FRDGTextureRef HoleAtlasTexture = HoleAtlas.RegisterMaskAtlas(GraphBuilder);
+			const FRDGTextureRef DistortionAtlasTexture = bWriteDistortion ? HoleAtlas.RegisterDistortionAtlas(GraphBuilder) : nullptr;
+
+			const FRDGTextureDesc CarveTexDesc = FRDGTextureDesc::Create3D(
+				Resolution,
+				PF_FloatRGBA,
+				FClearValueBinding::Black,
+				TexCreate_ShaderResource | TexCreate_UAV
 			);
+			const FRDGTextureRef RDGTexture = GraphBuilder.CreateTexture(CarveTexDesc, TEXT("IVSmokeHoleCarveTemp"));
 
 			// ============================================================================
 			// Pass 1: Hole Carve
 			// ============================================================================
+			// Bricks without holes keep the cleared value (no distortion, full density)
+			const FRDGTextureUAVRef VolumeUAV = GraphBuilder.CreateUAV(RDGTexture);
+			AddClearUAVPass(GraphBuilder, VolumeUAV, FVector4f(0.0f, 0.0f, 0.0f, 1.0f));
+
 			FIVSmokeHoleCarveCS::FParameters* CarveParameters = GraphBuilder.AllocParameters<FIVSmokeHoleCarveCS::FParameters>();
-			CarveParameters->VolumeTexture = GraphBuilder.CreateUAV(RDGTexture);
+			CarveParameters->VolumeTexture = VolumeUAV;
 			CarveParameters->HoleBuffer = GraphBuilder.CreateSRV(HoleBuffer);
+			CarveParameters->CurveLUTBuffer = GraphBuilder.CreateSRV(CurveLUTBuffer);
+			CarveParameters->BrickHoleRanges = GraphBuilder.CreateSRV(BrickRangeBuffer);
+			CarveParameters->BrickHoleIndices = GraphBuilder.CreateSRV(BrickHoleIndexBuffer);
+			CarveParameters->ActiveBricks = GraphBuilder.CreateSRV(ActiveBrickBuffer);
+			CarveParameters->BrickCount = Resources->BrickCount;
 			CarveParameters->VolumeMin = WorldVolumeMin;
 			CarveParameters->VolumeMax = WorldVolumeMax;
 			CarveParameters->Resolution = Resolution;
-			CarveParameters->NumHoles = NumHoles;
+			CarveParameters->CurrentServerTime = CurrentServerTime;
 
 			// Noise textures (use GWhiteTexture as fallback for null textures)
 			CarveParameters->PenetrationNoiseTexture = PenetrationNoiseTextureRHI ? PenetrationNoiseTextureRHI : GWhiteTexture->TextureRHI;
@@ -575,58 +799,50 @@ void UIVSmokeHoleGeneratorComponent::Local_RebuildHoleTexture()
 			CarveParameters->DynamicNoiseStrength = CapturedDynamicNoiseStrength;
 			CarveParameters->DynamicNoiseScale = CapturedDynamicNoiseScale;
 
-			const TShaderMapRef<FIVSmokeHoleCarveCS> CarveShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-			FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeHoleCarveCS>(GraphBuilder, GetGlobalShaderMap(GMaxRHIFeatureLevel), CarveShader, CarveParameters, Resolution);
+			// One thread group per non-empty brick
+			if (Resources->NumActiveBricks > 0)
+			{
+				const FIntVector CarveThreads(
+					Resources->NumActiveBricks * FIVSmokeHoleCarveCS::ThreadGroupSizeX,
+					FIVSmokeHoleCarveCS::ThreadGroupSizeY,
+					FIVSmokeHoleCarveCS::ThreadGroupSizeZ);
+				const TShaderMapRef<FIVSmokeHoleCarveCS> CarveShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+				FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeHoleCarveCS>(GraphBuilder, GetGlobalShaderMap(GMaxRHIFeatureLevel), CarveShader, CarveParameters, CarveThreads);
+			}
 
 			// ============================================================================
-			// Pass 2-4: Separable Gaussian Blur (X, Y, Z)
+			// Pass 2: Gaussian blur fused with the write into the hole atlas slot (compact formats pack mask / distortion)
 			// ============================================================================
-			if (CapturedBlurStep > 0)
-			{
-				// Create ping-pong texture for blur
-				const FRDGTextureDesc BlurTexDesc = FRDGTextureDesc::Create3D(
-					FIntVector(Resolution.X, Resolution.Y, Resolution.Z),
-					PF_FloatRGBA,
-					FClearValueBinding::Black,
-					TexCreate_ShaderResource | TexCreate_UAV
-				);
-				const FRDGTextureRef BlurTempTexture = GraphBuilder.CreateTexture(BlurTexDesc, TEXT("IVSmokeHoleBlurTemp"));
-
-				const TShaderMapRef<FIVSmokeHoleBlurCS> BlurShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
-				FRHISamplerState* LinearClampSampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+			const bool bCompact = AtlasLayout.IsCompact();
+			const bool bFusedBlur = CapturedBlurStep > 0;
 
-				// Blur directions
-				const FIntVector BlurDirections[3] = {
-					FIntVector(1, 0, 0),  // X
-					FIntVector(0, 1, 0),  // Y
-					FIntVector(0, 0, 1)   // Z
-				};
-
-				const FRDGTextureRef PingPong[2] = { RDGTexture, BlurTempTexture };
-				int32 CurrentInput = 0;
+			FIVSmokeHolePackCS::FParameters* PackParameters = GraphBuilder.AllocParameters<FIVSmokeHolePackCS::FParameters>();
+			PackParameters->InputTexture = GraphBuilder.CreateSRV(RDGTexture);
+			if (bCompact)
+			{
+				PackParameters->MaskTexture = GraphBuilder.CreateUAV(HoleAtlasTexture);
+			}
+			else
+			{
+				PackParameters->HoleTexture = GraphBuilder.CreateUAV(HoleAtlasTexture);
+			}
+			if (DistortionAtlasTexture)
+			{
+				PackParameters->DistortionTexture = GraphBuilder.CreateUAV(DistortionAtlasTexture);
+			}
+			PackParameters->Resolution = Resolution;
+			PackParameters->SlotOffset = AtlasLayout.GetSlotOffset(Slot);
+			PackParameters->DistortionRange = CapturedDistortionRange;
+			PackParameters->BlurStep = FMath::Min(CapturedBlurStep, FIVSmokeHolePackCS::MaxBlurStep);
 
-				for (int32 i = 0; i < 3; ++i)
-				{
-					FIVSmokeHoleBlurCS::FParameters* BlurParameters = GraphBuilder.AllocParameters<FIVSmokeHoleBlurCS::FParameters>();
-					BlurParameters->InputTexture = GraphBuilder.CreateSRV(PingPong[CurrentInput]);
-					BlurParameters->InputSampler = LinearClampSampler;
-					BlurParameters->OutputTexture = GraphBuilder.CreateUAV(PingPong[1 - CurrentInput]);
-					BlurParameters->Resolution = Resolution;
-					BlurParameters->BlurDirection = BlurDirections[i];
-					BlurParameters->BlurStep = CapturedBlurStep;
-
-					FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeHoleBlurCS>(GraphBuilder,
-						GetGlobalShaderMap(GMaxRHIFeatureLevel), BlurShader, BlurParameters, Resolution);
-
-					CurrentInput = 1 - CurrentInput;
-				}
+			FIVSmokeHolePackCS::FPermutationDomain PackPermutation;
+			PackPermutation.Set<FIVSmokeHolePackCS::FCompactMaskDim>(bCompact);
+			PackPermutation.Set<FIVSmokeHolePackCS::FWriteDistortionDim>(DistortionAtlasTexture != nullptr);
+			PackPermutation.Set<FIVSmokeHolePackCS::FFusedBlurDim>(bFusedBlur);
 
-				// If final result is in BlurTempTexture (CurrentInput == 1), copy back to RDGTexture
-				if (CurrentInput == 1)
-				{
-					AddCopyTexturePass(GraphBuilder, BlurTempTexture, RDGTexture, FRHICopyTextureInfo());
-				}
-			}
+			const TShaderMapRef<FIVSmokeHolePackCS> PackShader(GetGlobalShaderMap(GMaxRHIFeatureLevel), PackPermutation);
+			FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeHolePackCS>(GraphBuilder,
+				GetGlobalShaderMap(GMaxRHIFeatureLevel), PackShader, PackParameters, Resolution);
 
 			GraphBuilder.Execute();
 		}
@@ -651,6 +867,17 @@ float UIVSmokeHoleGeneratorComponent::GetSyncedTime() const
 	return 0.0f;
 }
 
+FBox3f UIVSmokeHoleGeneratorComponent::GetNetQuantizationBounds() const
+{
+	if (const TObjectPtr<AIVSmokeVoxelVolume> VoxelVolume = Cast<AIVSmokeVoxelVolume>(GetOwner()))
+	{
+		// Full grid plus one voxel of padding, same as the voxel world AABB
+		const FVector HalfSize = FVector(VoxelVolume->VolumeExtent) * VoxelVolume->GetVoxelSize();
+		return FBox3f(FBox(-HalfSize, HalfSize).TransformBy(VoxelVolume->GetActorTransform()));
+	}
+	return FBox3f(ForceInit);
+}
+
 #if !UE_SERVER
 void UIVSmokeHoleGeneratorComponent::SetBoxToVoxelAABB()
 {
@@ -665,19 +892,6 @@ void UIVSmokeHoleGeneratorComponent::SetBoxToVoxelAABB()
 		SetBoxExtent(Extent, false);
 	}
 }
-
-FTextureRHIRef UIVSmokeHoleGeneratorComponent::GetHoleTextureRHI() const
-{
-	if (HoleTexture)
-	{
-		if (const FTextureRenderTargetResource* Resource = HoleTexture->GameThread_GetRenderTargetResource())
-		{
-			return Resource->GetRenderTargetTexture();
-		}
-	}
-
-	return nullptr;
-}
 #endif
 
 #pragma endregion
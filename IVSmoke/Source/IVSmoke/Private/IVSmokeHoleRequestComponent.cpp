@@ -10,9 +10,23 @@
 
 UIVSmokeHoleRequestComponent::UIVSmokeHoleRequestComponent()
 {
+	// Only ticks while penetration requests are queued
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	SetIsReplicatedByDefault(true);
 }
 
+void UIVSmokeHoleRequestComponent::TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	PenetrationBatchElapsed += DeltaTime;
+	if (PenetrationBatchElapsed >= PenetrationBatchInterval)
+	{
+		FlushPenetrationHoles();
+	}
+}
+
 UIVSmokeHoleRequestComponent* UIVSmokeHoleRequestComponent::GetHoleRequester(const APawn* Instigator)
 {
 	if (!Instigator)
@@ -64,6 +78,62 @@ void UIVSmokeHoleRequestComponent::RequestPenetrationHole_Implementation(UIVSmok
 	IVSmokeHoleGeneratorComponent->CreatePenetrationHole(Origin, Direction, Preset->GetPresetID());
 }
 
+void UIVSmokeHoleRequestComponent::RequestPenetrationHoles_Implementation(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const TArray<FIVSmokePenetrationRequest>& Requests)
+{
+	if (!IVSmokeHoleGeneratorComponent)
+	{
+		UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleRequestComponent::RequestPenetrationHoles] IVSmokeHoleGeneratorComponent is null"));
+		return;
+	}
+
+	if (Requests.Num() > MaxPenetrationBatchSize)
+	{
+		UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleRequestComponent::RequestPenetrationHoles] Batch of %d truncated to %d"), Requests.Num(), MaxPenetrationBatchSize);
+	}
+
+	// Preset validation is done per request by the generator
+	IVSmokeHoleGeneratorComponent->CreatePenetrationHoles(TConstArrayView<FIVSmokePenetrationRequest>(Requests).Left(MaxPenetrationBatchSize));
+}
+
+void UIVSmokeHoleRequestComponent::QueuePenetrationHole(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const FVector3f& Origin, const FVector3f& Direction, UIVSmokeHolePreset* Preset)
+{
+	if (!IVSmokeHoleGeneratorComponent || !Preset)
+	{
+		UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleRequestComponent::QueuePenetrationHole] IVSmokeHoleGeneratorComponent or Preset is null"));
+		return;
+	}
+
+	TArray<FIVSmokePenetrationRequest>& Pending = PendingPenetrationRequests.FindOrAdd(IVSmokeHoleGeneratorComponent);
+	FIVSmokePenetrationRequest& Request = Pending.AddDefaulted_GetRef();
+	Request.Origin = Origin;
+	Request.Direction = Direction;
+	Request.Preset = Preset;
+
+	// Full batches are sent right away
+	if (Pending.Num() >= MaxPenetrationBatchSize)
+	{
+		RequestPenetrationHoles(IVSmokeHoleGeneratorComponent, Pending);
+		Pending.Reset();
+	}
+
+	SetComponentTickEnabled(true);
+}
+
+void UIVSmokeHoleRequestComponent::FlushPenetrationHoles()
+{
+	for (TPair<TWeakObjectPtr<UIVSmokeHoleGeneratorComponent>, TArray<FIVSmokePenetrationRequest>>& Pair : PendingPenetrationRequests)
+	{
+		if (UIVSmokeHoleGeneratorComponent* Generator = Pair.Key.Get(); Generator && Pair.Value.Num() > 0)
+		{
+			RequestPenetrationHoles(Generator, Pair.Value);
+		}
+	}
+
+	PendingPenetrationRequests.Reset();
+	PenetrationBatchElapsed = 0.0f;
+	SetComponentTickEnabled(false);
+}
+
 void UIVSmokeHoleRequestComponent::RequestExplosionHole_Implementation(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const FVector3f& Origin, UIVSmokeHolePreset* Preset)
 {
 	if (!IVSmokeHoleGeneratorComponent)
@@ -1,6 +1,510 @@
 // Copyright (c) 2026, Team SDB. All rights reserved.
 
 #include "IVSmokeHoleShaders.h"
+#include "IVSmokeHolePreset.h"
+#include "Async/ParallelFor.h"
 
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeHoleCarveCS, "/Plugin/IVSmoke/IVSmokeHoleCarveCS.usf", "MainCS", SF_Compute);
-IMPLEMENT_GLOBAL_SHADER(FIVSmokeHoleBlurCS, "/Plugin/IVSmoke/IVSmokeHoleBlurCS.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FIVSmokeHolePackCS, "/Plugin/IVSmoke/IVSmokeHolePackCS.usf", "MainCS", SF_Compute);
+
+//~============================================================================
+// Hole Brick Binning
+
+namespace
+{
+	/** Largest value of a fade range curve row, or DefaultMax when the hole uses the linear fallback. */
+	float GetCurveLUTMax(const TArray<float>& CurveLUT, const int32 CurveIndex, const float DefaultMax)
+	{
+		const int32 RowOffset = CurveIndex * FIVSmokeHoleCarveCS::CurveLUTSize;
+		if (CurveIndex == INDEX_NONE || !CurveLUT.IsValidIndex(RowOffset + FIVSmokeHoleCarveCS::CurveLUTSize - 1))
+		{
+			return DefaultMax;
+		}
+
+		float MaxValue = 0.0f;
+		for (uint32 i = 0; i < FIVSmokeHoleCarveCS::CurveLUTSize; ++i)
+		{
+			MaxValue = FMath::Max(MaxValue, CurveLUT[RowOffset + i]);
+		}
+		return MaxValue;
+	}
+
+	/**
+	 * Conservative world space bounds of every voxel a hole can touch during its lifetime.
+	 * Mirrors the falloff and edge noise ranges of IVSmokeHoleCarveCS.usf.
+	 */
+	FBox3f GetHoleCarveBounds(const FIVSmokeHoleGPU& Hole, const TArray<float>& CurveLUT)
+	{
+		switch (static_cast<EIVSmokeHoleType>(Hole.HoleType))
+		{
+		case EIVSmokeHoleType::Penetration:
+		{
+			// Edge noise pushes the surface out by at most one edge width (<= radius at t)
+			const float CapsuleRadius = 2.0f * FMath::Max(Hole.Radius, Hole.EndRadius);
+			FBox3f Bounds(Hole.Position, Hole.Position);
+			Bounds += Hole.EndPosition;
+			return Bounds.ExpandBy(CapsuleRadius);
+		}
+		case EIVSmokeHoleType::Explosion:
+		{
+			// Outside the largest fade range plus softness the hole is fully transparent,
+			// and distortion is only written inside Radius
+			const float MaxFadeRange = Hole.Radius * FMath::Max3(1.0f,
+				GetCurveLUTMax(CurveLUT, Hole.ExpansionCurveIndex, 1.0f),
+				GetCurveLUTMax(CurveLUT, Hole.ShrinkCurveIndex, 1.0f));
+			const float BoundRadius = MaxFadeRange + Hole.Radius * Hole.Softness;
+
+			// The shader scales the vertical offset by 0.7, stretching the sphere along Z
+			const FVector3f HalfExtent(BoundRadius, BoundRadius, BoundRadius / 0.7f);
+			return FBox3f(Hole.Position - HalfExtent, Hole.Position + HalfExtent);
+		}
+		case EIVSmokeHoleType::Dynamic:
+		default:
+		{
+			// Same movement aligned frame as the shader
+			const FVector3f Diff = Hole.EndPosition - Hole.Position;
+			const float MoveLen = Diff.Size();
+			const FVector3f Forward = MoveLen > 0.1f ? Diff / MoveLen : FVector3f::UpVector;
+			FVector3f Up = FMath::Abs(Forward.Z) < 0.999f ? FVector3f::UpVector : FVector3f::ForwardVector;
+			const FVector3f Right = FVector3f::CrossProduct(Up, Forward).GetSafeNormal();
+			Up = FVector3f::CrossProduct(Forward, Right);
+
+			FVector3f HalfExtent = Hole.Extent * 0.5f;
+			HalfExtent.Y += MoveLen * 0.5f;
+			const float CapRadius = HalfExtent.X;
+			const float FalloffWidth = FMath::Max(1.0f, Hole.Softness * CapRadius);
+
+			// Box body plus sphere caps, grown by the noise falloff
+			const FVector3f LocalExtent(
+				CapRadius + FalloffWidth,
+				FMath::Max(HalfExtent.Y, CapRadius) + FalloffWidth,
+				HalfExtent.Z * 0.8f + CapRadius + FalloffWidth);
+			const FVector3f WorldExtent = Right.GetAbs() * LocalExtent.X + Forward.GetAbs() * LocalExtent.Y + Up.GetAbs() * LocalExtent.Z;
+			const FVector3f Center = (Hole.Position + Hole.EndPosition) * 0.5f;
+			return FBox3f(Center - WorldExtent, Center + WorldExtent);
+		}
+		}
+	}
+
+	float PointSegmentDistSquared(const FVector3f& Point, const FVector3f& Start, const FVector3f& End)
+	{
+		const FVector3f Segment = End - Start;
+		const float SegmentLengthSquared = Segment.SizeSquared();
+		const float T = SegmentLengthSquared > UE_SMALL_NUMBER
+			? FMath::Clamp(FVector3f::DotProduct(Point - Start, Segment) / SegmentLengthSquared, 0.0f, 1.0f)
+			: 0.0f;
+		return FVector3f::DistSquared(Point, Start + Segment * T);
+	}
+}
+
+void FIVSmokeHoleBrickBins::Build(const TArray<FIVSmokeHoleGPU>& Holes, const TArray<float>& CurveLUT,
+	const FVector3f& VolumeMin, const FVector3f& VolumeMax, const FIntVector& Resolution)
+{
+	static_assert(BrickSize == FIVSmokeHoleCarveCS::ThreadGroupSizeX
+		&& BrickSize == FIVSmokeHoleCarveCS::ThreadGroupSizeY
+		&& BrickSize == FIVSmokeHoleCarveCS::ThreadGroupSizeZ,
+		"One carve thread group must cover exactly one brick.");
+
+	BrickCount = FIntVector(
+		FMath::DivideAndRoundUp(FMath::Max(Resolution.X, 1), BrickSize),
+		FMath::DivideAndRoundUp(FMath::Max(Resolution.Y, 1), BrickSize),
+		FMath::DivideAndRoundUp(FMath::Max(Resolution.Z, 1), BrickSize));
+	const int32 NumBricks = BrickCount.X * BrickCount.Y * BrickCount.Z;
+
+	BrickRanges.Reset();
+	BrickRanges.SetNumZeroed(NumBricks);
+	BrickHoleIndices.Reset();
+	ActiveBricks.Reset();
+
+	const FVector3f BrickWorldSize = (VolumeMax - VolumeMin) * static_cast<float>(BrickSize) / FVector3f(Resolution);
+	if (BrickWorldSize.GetMin() <= 0.0f)
+	{
+		return;
+	}
+	const FBox3f VolumeBounds(VolumeMin, VolumeMax);
+	const float BrickHalfDiagonal = BrickWorldSize.Size() * 0.5f;
+
+	// 1. Gather (Brick, Hole) pairs in hole buffer order
+	TArray<FUintVector2> Pairs;
+	for (int32 HoleIdx = 0; HoleIdx < Holes.Num(); ++HoleIdx)
+	{
+		const FIVSmokeHoleGPU& Hole = Holes[HoleIdx];
+		if (Hole.Duration <= 0.0f)
+		{
+			continue;
+		}
+
+		const FBox3f Bounds = GetHoleCarveBounds(Hole, CurveLUT);
+		if (!VolumeBounds.Intersect(Bounds))
+		{
+			continue;
+		}
+
+		const FVector3f MinBrickCoord = (Bounds.Min - VolumeMin) / BrickWorldSize;
+		const FVector3f MaxBrickCoord = (Bounds.Max - VolumeMin) / BrickWorldSize;
+		const FIntVector MinBrick(
+			FMath::Clamp(FMath::FloorToInt32(MinBrickCoord.X), 0, BrickCount.X - 1),
+			FMath::Clamp(FMath::FloorToInt32(MinBrickCoord.Y), 0, BrickCount.Y - 1),
+			FMath::Clamp(FMath::FloorToInt32(MinBrickCoord.Z), 0, BrickCount.Z - 1));
+		const FIntVector MaxBrick(
+			FMath::Clamp(FMath::FloorToInt32(MaxBrickCoord.X), 0, BrickCount.X - 1),
+			FMath::Clamp(FMath::FloorToInt32(MaxBrickCoord.Y), 0, BrickCount.Y - 1),
+			FMath::Clamp(FMath::FloorToInt32(MaxBrickCoord.Z), 0, BrickCount.Z - 1));
+
+		// Diagonal bullets have loose boxes, refine them against the capsule per brick
+		const bool bCapsuleTest = Hole.HoleType == static_cast<int32>(EIVSmokeHoleType::Penetration);
+		const float CapsuleReach = 2.0f * FMath::Max(Hole.Radius, Hole.EndRadius) + BrickHalfDiagonal;
+
+		for (int32 z = MinBrick.Z; z <= MaxBrick.Z; ++z)
+		{
+			for (int32 y = MinBrick.Y; y <= MaxBrick.Y; ++y)
+			{
+				for (int32 x = MinBrick.X; x <= MaxBrick.X; ++x)
+				{
+					if (bCapsuleTest)
+					{
+						const FVector3f BrickCenter = VolumeMin + (FVector3f(FIntVector(x, y, z)) + 0.5f) * BrickWorldSize;
+						if (PointSegmentDistSquared(BrickCenter, Hole.Position, Hole.EndPosition) > FMath::Square(CapsuleReach))
+						{
+							continue;
+						}
+					}
+
+					const uint32 BrickIndex = x + y * BrickCount.X + z * BrickCount.X * BrickCount.Y;
+					Pairs.Emplace(BrickIndex, static_cast<uint32>(HoleIdx));
+				}
+			}
+		}
+	}
+
+	// 2. Counting sort by brick. Stable, so explosions stay ahead of penetrations inside every brick
+	for (const FUintVector2& Pair : Pairs)
+	{
+		++BrickRanges[Pair.X].Y;
+	}
+
+	uint32 Offset = 0;
+	for (int32 BrickIndex = 0; BrickIndex < NumBricks; ++BrickIndex)
+	{
+		BrickRanges[BrickIndex].X = Offset;
+		Offset += BrickRanges[BrickIndex].Y;
+		if (BrickRanges[BrickIndex].Y > 0)
+		{
+			ActiveBricks.Add(BrickIndex);
+		}
+	}
+
+	BrickHoleIndices.SetNumUninitialized(Pairs.Num());
+	TArray<uint32> WriteCursor;
+	WriteCursor.SetNumZeroed(NumBricks);
+	for (const FUintVector2& Pair : Pairs)
+	{
+		BrickHoleIndices[BrickRanges[Pair.X].X + WriteCursor[Pair.X]++] = Pair.Y;
+	}
+}
+
+//~============================================================================
+// CPU Hole Carve
+
+namespace
+{
+	float Saturate(const float Value)
+	{
+		return FMath::Clamp(Value, 0.0f, 1.0f);
+	}
+
+	float SphereSdf(const FVector3f& Point, const FVector3f& Center, const float SphereRadius)
+	{
+		return (Point - Center).Size() - SphereRadius;
+	}
+
+	float BoxSdf(const FVector3f& Point, const FVector3f& BoxHalfExtent)
+	{
+		const FVector3f PointMinusExtent = Point.GetAbs() - BoxHalfExtent;
+		const float DistOutside = PointMinusExtent.ComponentMax(FVector3f::ZeroVector).Size();
+		const float DistInside = FMath::Min(PointMinusExtent.GetMax(), 0.0f);
+		return DistOutside + DistInside;
+	}
+}
+
+FIVSmokeHoleCarveCPU::FIVSmokeHoleCarveCPU(TArray<FIVSmokeHoleGPU> InHoles, TArray<float> InCurveLUT, const FVector3f& InVolumeMin, const FVector3f& InVolumeMax)
+	: Holes(MoveTemp(InHoles))
+	, CurveLUT(MoveTemp(InCurveLUT))
+	, VolumeMin(InVolumeMin)
+	, VolumeMax(InVolumeMax)
+{
+	AllHoleIndices.SetNumUninitialized(Holes.Num());
+	for (int32 HoleIndex = 0; HoleIndex < Holes.Num(); ++HoleIndex)
+	{
+		AllHoleIndices[HoleIndex] = HoleIndex;
+	}
+}
+
+FVector4f FIVSmokeHoleCarveCPU::Evaluate(const FVector3f& WorldPos, const float CurrentServerTime) const
+{
+	return EvaluateHoles(WorldPos, CurrentServerTime, AllHoleIndices);
+}
+
+void FIVSmokeHoleCarveCPU::Carve(const FIntVector& Resolution, const float CurrentServerTime, TArray<FVector4f>& OutVolume) const
+{
+	constexpr int32 BrickSize = FIVSmokeHoleBrickBins::BrickSize;
+
+	// Bricks without holes keep the cleared value (no distortion, full density)
+	OutVolume.Init(FVector4f(0.0f, 0.0f, 0.0f, 1.0f), Resolution.X * Resolution.Y * Resolution.Z);
+
+	FIVSmokeHoleBrickBins BrickBins;
+	BrickBins.Build(Holes, CurveLUT, VolumeMin, VolumeMax, Resolution);
+
+	const FVector3f VoxelSize = (VolumeMax - VolumeMin) / FVector3f(Resolution);
+	ParallelFor(BrickBins.ActiveBricks.Num(), [&](const int32 ActiveIndex)
+	{
+		const uint32 BrickIndex = BrickBins.ActiveBricks[ActiveIndex];
+		const FIntVector BrickCoord(
+			BrickIndex % BrickBins.BrickCount.X,
+			(BrickIndex / BrickBins.BrickCount.X) % BrickBins.BrickCount.Y,
+			BrickIndex / (BrickBins.BrickCount.X * BrickBins.BrickCount.Y));
+		const FUintVector2 Range = BrickBins.BrickRanges[BrickIndex];
+		const TConstArrayView<uint32> BrickHoles(BrickBins.BrickHoleIndices.GetData() + Range.X, Range.Y);
+
+		const FIntVector BrickMin = BrickCoord * BrickSize;
+		const FIntVector BrickMax(
+			FMath::Min(BrickMin.X + BrickSize, Resolution.X),
+			FMath::Min(BrickMin.Y + BrickSize, Resolution.Y),
+			FMath::Min(BrickMin.Z + BrickSize, Resolution.Z));
+		for (int32 Z = BrickMin.Z; Z < BrickMax.Z; ++Z)
+		{
+			for (int32 Y = BrickMin.Y; Y < BrickMax.Y; ++Y)
+			{
+				for (int32 X = BrickMin.X; X < BrickMax.X; ++X)
+				{
+					const FVector3f WorldPos = VolumeMin + (FVector3f(X, Y, Z) + 0.5f) * VoxelSize;
+					OutVolume[X + (Y + Z * Resolution.Y) * Resolution.X] = EvaluateHoles(WorldPos, CurrentServerTime, BrickHoles);
+				}
+			}
+		}
+	});
+}
+
+FVector4f FIVSmokeHoleCarveCPU::EvaluateHoles(const FVector3f& WorldPos, const float CurrentServerTime, TConstArrayView<uint32> HoleIndices) const
+{
+	const FVector3f UVW = (WorldPos - VolumeMin) / (VolumeMax - VolumeMin);
+
+	FVector4f ExplosionResult(0.0f, 0.0f, 0.0f, 1.0f);
+	float PenetrationDensity = 1.0f;
+	float DynamicDensity = 1.0f;
+	float ExplosionFadePenetration = 0.0f;
+	float ExplosionFadePenetrationTime = 0.0f;
+
+	for (const uint32 HoleIndex : HoleIndices)
+	{
+		const FIVSmokeHoleGPU& Hole = Holes[HoleIndex];
+
+		// Skip fully faded holes
+		if (Hole.Duration < CurrentServerTime - Hole.SpawnServerTime)
+		{
+			continue;
+		}
+
+		if (Hole.HoleType == static_cast<int32>(EIVSmokeHoleType::Explosion))
+		{
+			float CurFadePenetration = 1.0f;
+			float CurFadePenetrationTime = 0.0f;
+			const FVector4f CurExplosionResult = Explosion(Hole, WorldPos, UVW, CurrentServerTime, CurFadePenetration, CurFadePenetrationTime);
+
+			ExplosionResult.X += CurExplosionResult.X;
+			ExplosionResult.Y += CurExplosionResult.Y;
+			ExplosionResult.Z += CurExplosionResult.Z;
+			ExplosionResult.W = FMath::Min(ExplosionResult.W, CurExplosionResult.W);
+
+			if (CurFadePenetration > ExplosionFadePenetration)
+			{
+				ExplosionFadePenetration = CurFadePenetration;
+				ExplosionFadePenetrationTime = CurFadePenetrationTime;
+			}
+		}
+		else if (Hole.HoleType == static_cast<int32>(EIVSmokeHoleType::Penetration))
+		{
+			float HoleMakeTime = 0.0f;
+			float Density = Penetration(Hole, WorldPos, CurrentServerTime, HoleMakeTime).W;
+			if (HoleMakeTime < ExplosionFadePenetrationTime)
+			{
+				Density = 1.0f - (1.0f - Density) * (1.0f - ExplosionFadePenetration);
+			}
+			PenetrationDensity = FMath::Min(PenetrationDensity, Density);
+		}
+		else
+		{
+			DynamicDensity = FMath::Min(DynamicDensity, Dynamic(Hole, WorldPos, CurrentServerTime));
+		}
+	}
+
+	ExplosionResult.W = FMath::Min(DynamicDensity, FMath::Min(ExplosionResult.W, PenetrationDensity));
+	return ExplosionResult;
+}
+
+float FIVSmokeHoleCarveCPU::SampleCurveLUT(const int32 CurveIndex, const float NormalizedTime, const float DefaultValue) const
+{
+	constexpr int32 LUTSize = FIVSmokeHoleCarveCS::CurveLUTSize;
+	const int32 RowOffset = CurveIndex * LUTSize;
+	if (CurveIndex < 0 || !CurveLUT.IsValidIndex(RowOffset + LUTSize - 1))
+	{
+		return DefaultValue;
+	}
+
+	const float LUTCoord = Saturate(NormalizedTime) * (LUTSize - 1);
+	const int32 LUTIndex0 = FMath::Min(static_cast<int32>(LUTCoord), LUTSize - 1);
+	const int32 LUTIndex1 = FMath::Min(LUTIndex0 + 1, LUTSize - 1);
+	return FMath::Lerp(CurveLUT[RowOffset + LUTIndex0], CurveLUT[RowOffset + LUTIndex1], LUTCoord - LUTIndex0);
+}
+
+FVector4f FIVSmokeHoleCarveCPU::Explosion(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const FVector3f& UVW, const float CurrentServerTime,
+	float& OutFadePenetration, float& OutFadePenetrationTime) const
+{
+	FVector4f Result(0.0f, 0.0f, 0.0f, 1.0f);
+	FVector3f Offset = WorldPos - Hole.Position;
+	Offset.Z *= 0.7f;
+	const FVector3f Dir = Offset.GetSafeNormal();
+	const float Dis = Offset.Size();
+
+	const float Radius = Hole.Radius;
+	const float SoftnessRange = Radius * Hole.Softness;
+	const float SafeSoftnessRange = FMath::Max(SoftnessRange, 0.001f);
+
+	const float VolumeHeight = VolumeMax.Z - VolumeMin.Z;
+	float AlphaHeight = 100.0f;
+
+	const float CurLifeTime = CurrentServerTime - Hole.SpawnServerTime;
+	const float ExpansionNormalizedTime = Saturate(CurLifeTime / FMath::Max(0.001f, Hole.ExpansionDuration));
+	const float CurExpansionFadeRangeOverTime = SampleCurveLUT(Hole.ExpansionCurveIndex, ExpansionNormalizedTime, ExpansionNormalizedTime);
+
+	// Penetration fade
+	OutFadePenetration = Dis > Radius ? 0.0f : ExpansionNormalizedTime;
+	OutFadePenetrationTime = Hole.ExpansionDuration >= CurLifeTime ? 0.0f : Hole.ExpansionDuration - CurLifeTime;
+
+	if (CurLifeTime < Hole.ExpansionDuration)
+	{
+		// Expansion
+		const float CurFadeRange = CurExpansionFadeRangeOverTime * Radius;
+		const float SoftnessStart = CurFadeRange - SoftnessRange;
+		Result.W = Saturate((Dis - SoftnessStart) / SafeSoftnessRange);
+
+		// Expansion distortion
+		const float DistortionOverTime = Saturate(1.0f - FMath::Pow(1.0f - ExpansionNormalizedTime, Hole.DistortionExpOverTime));
+		const float DistortionOverDistance = FMath::SmoothStep(0.0f, 1.0f, 1.0f - Dis / Radius);
+		const float CurDistortionDistance = Hole.DistortionDistance * DistortionOverTime * DistortionOverDistance;
+		if (CurDistortionDistance > 0.0f)
+		{
+			const FVector3f Distortion = -Dir * CurDistortionDistance;
+			Result = FVector4f(Distortion.X, Distortion.Y, Distortion.Z, Result.W);
+		}
+
+		// Distortion artifact case
+		if (UVW.Z * VolumeHeight < AlphaHeight)
+		{
+			Result = FVector4f(0.0f, 0.0f, 0.0f, Result.W);
+		}
+	}
+	else
+	{
+		// Shrink
+		const float ShrinkNormalizedTime = Saturate((CurLifeTime - Hole.ExpansionDuration) / FMath::Max(0.001f, Hole.Duration - Hole.ExpansionDuration));
+		const float CurShrinkFadeRangeOverTime = SampleCurveLUT(Hole.ShrinkCurveIndex, ShrinkNormalizedTime, 1.0f - ShrinkNormalizedTime);
+		const float CurFadeRange = CurShrinkFadeRangeOverTime * Radius;
+		const float SoftnessStart = CurFadeRange - SoftnessRange;
+
+		const float LastExpansionFadeRange = CurExpansionFadeRangeOverTime * Radius;
+		const float LastExpansionSoftnessStart = LastExpansionFadeRange - SoftnessRange;
+
+		const float LastExpansionAlpha = Saturate((Dis - LastExpansionSoftnessStart) / SafeSoftnessRange);
+		const float ShrinkAlpha = Saturate((Dis - SoftnessStart) / SafeSoftnessRange);
+		const float AlphaOverTime = Dis < CurFadeRange ? Saturate(Dis / CurFadeRange) * ShrinkNormalizedTime : 1.0f;
+
+		Result.W = FMath::Lerp(LastExpansionAlpha, ShrinkAlpha, ShrinkNormalizedTime);
+		Result.W = FMath::Lerp(Result.W, FMath::Pow(AlphaOverTime, 1.5f), ShrinkNormalizedTime);
+
+		AlphaHeight = AlphaHeight + FMath::Pow(ShrinkNormalizedTime, 5.5f) * (VolumeHeight - AlphaHeight);
+	}
+
+	// Height fade
+	const float AlphaHeightUVZ = FMath::Max(0.01f, AlphaHeight / VolumeHeight);
+	const float HeightDensity = FMath::Pow(1.0f - Saturate(UVW.Z / AlphaHeightUVZ), 1.2f);
+	Result.W = FMath::Max(Result.W, HeightDensity);
+
+	return Result;
+}
+
+FVector4f FIVSmokeHoleCarveCPU::Penetration(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const float CurrentServerTime, float& OutHoleMakeTime) const
+{
+	FVector4f Result(0.0f, 0.0f, 0.0f, 1.0f);
+
+	const FVector3f StartToEnd = Hole.EndPosition - Hole.Position;
+	const FVector3f StartToCur = WorldPos - Hole.Position;
+	const float LengthStartToEnd = StartToEnd.Size();
+
+	FVector3f DirStartToEnd = FVector3f::ZeroVector;
+	float T = 0.0f;
+	float TClamped = 0.0f;
+	if (LengthStartToEnd >= 0.0001f)
+	{
+		DirStartToEnd = StartToEnd / LengthStartToEnd;
+		T = FVector3f::DotProduct(StartToCur, DirStartToEnd);
+		TClamped = T / LengthStartToEnd;
+	}
+
+	if (TClamped < 0.0f || TClamped > 1.0f)
+	{
+		return Result;
+	}
+
+	const float RadiusAtT = FMath::Lerp(Hole.Radius, Hole.EndRadius, TClamped);
+	const FVector3f ClosestPoint = Hole.Position + DirStartToEnd * T;
+	const float DisToAxis = (WorldPos - ClosestPoint).Size();
+
+	const float EdgeWidth = RadiusAtT * Saturate(Hole.Softness + 0.1f);
+	const float Dist = DisToAxis - RadiusAtT;
+
+	if (Dist < 0.0f)
+	{
+		const float CurLifeTime = CurrentServerTime - Hole.SpawnServerTime;
+		const float Falloff = Saturate(-Dist / FMath::Max(EdgeWidth, 0.01f));
+		const float NormalizedTime = CurLifeTime / Hole.Duration;
+		const float FadeOut = 1.0f - FMath::Pow(NormalizedTime, 3.5f);
+		Result.W = 1.0f - Falloff * FadeOut;
+		OutHoleMakeTime = -CurLifeTime;
+	}
+	return Result;
+}
+
+float FIVSmokeHoleCarveCPU::Dynamic(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const float CurrentServerTime) const
+{
+	// 1. Local frame aligned to the movement direction
+	const FVector3f Diff = Hole.EndPosition - Hole.Position;
+	const float MoveLen = Diff.Size();
+	const FVector3f Forward = MoveLen > 0.1f ? Diff / MoveLen : FVector3f(0.0f, 0.0f, 1.0f);
+	FVector3f Up = FMath::Abs(Forward.Z) < 0.999f ? FVector3f(0.0f, 0.0f, 1.0f) : FVector3f(1.0f, 0.0f, 0.0f);
+	const FVector3f Right = FVector3f::CrossProduct(Up, Forward).GetSafeNormal();
+	Up = FVector3f::CrossProduct(Forward, Right);
+
+	const FVector3f LocalPos = WorldPos - (Hole.Position + Hole.EndPosition) * 0.5f;
+	const FVector3f P(FVector3f::DotProduct(LocalPos, Right), FVector3f::DotProduct(LocalPos, Forward), FVector3f::DotProduct(LocalPos, Up));
+
+	// 2. Capsule half extents, stretched along the trajectory
+	FVector3f HalfExtent = Hole.Extent * 0.5f;
+	HalfExtent.Y += MoveLen * 0.5f;
+	const float CapRadius = HalfExtent.X;
+	const float BodyHalfHeight = HalfExtent.Z * 0.8f;
+
+	// 3. Union of box body and two sphere caps
+	const float DBox = BoxSdf(P, FVector3f(HalfExtent.X, HalfExtent.Y, BodyHalfHeight));
+	const float DSphereTop = SphereSdf(P, FVector3f(0.0f, 0.0f, BodyHalfHeight), CapRadius);
+	const float DSphereBot = SphereSdf(P, FVector3f(0.0f, 0.0f, -BodyHalfHeight), CapRadius);
+	const float Dist = FMath::Min(DBox, FMath::Min(DSphereTop, DSphereBot));
+
+	// 4. Falloff and fade over lifetime
+	const float FalloffWidth = FMath::Max(1.0f, Hole.Softness * CapRadius);
+	const float LifetimeRatio = (CurrentServerTime - Hole.SpawnServerTime) / Hole.Duration;
+	const float Fade = 1.0f - LifetimeRatio * LifetimeRatio;
+	const float HoleDensity = Saturate(-Dist / FalloffWidth);
+
+	return 1.0f - HoleDensity * Fade;
+}
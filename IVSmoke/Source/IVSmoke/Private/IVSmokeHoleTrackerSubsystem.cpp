@@ -0,0 +1,203 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#include "IVSmokeHoleTrackerSubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "IVSmoke.h"
+#include "IVSmokeHoleGeneratorComponent.h"
+#include "IVSmokeHolePreset.h"
+
+UIVSmokeHoleTrackerSubsystem* UIVSmokeHoleTrackerSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UIVSmokeHoleTrackerSubsystem>() : nullptr;
+}
+
+TStatId UIVSmokeHoleTrackerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UIVSmokeHoleTrackerSubsystem, STATGROUP_Tickables);
+}
+
+void UIVSmokeHoleTrackerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Subjects.Num() == 0 || Generators.Num() == 0 || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// 1. Broad phase over generators, once per tick
+	RebuildGeneratorCells();
+	if (Generators.Num() == 0)
+	{
+		return;
+	}
+	const float CurrentTime = Generators[0]->GetSyncedTime();
+
+	// 2. Poll each subject once and route it to the generators containing it
+	for (int32 i = Subjects.Num() - 1; i >= 0; --i)
+	{
+		FIVSmokeHoleDynamicSubject& Subject = Subjects[i];
+
+		// 0. Delete if object, restricted generator or preset is not alive
+		const TObjectPtr<UIVSmokeHolePreset> Preset = UIVSmokeHolePreset::FindByID(Subject.PresetID);
+		if (!Subject.IsValid() || (!Subject.Generator.IsExplicitlyNull() && !Subject.Generator.IsValid()) || !Preset)
+		{
+			Subjects.RemoveAtSwap(i);
+			continue;
+		}
+
+		const AActor* Actor = Subject.TargetActor.Get();
+		const FVector3f CurrentPos = FVector3f(Actor->GetActorLocation());
+		const FVector3f LastPos = Subject.LastWorldPosition;
+
+		// 1. Ignore if object moves a little bit
+		if (Preset->DistanceThreshold > FVector3f::Dist(CurrentPos, LastPos))
+		{
+			continue;
+		}
+
+		// 2. Track the move even outside every generator, so a subject entering smoke
+		//    does not carve a tunnel from wherever it last made a hole
+		Subject.LastWorldPosition = CurrentPos;
+		Subject.LastWorldRotation = Actor->GetActorQuat();
+
+		const TArray<int32, TInlineAllocator<4>>* Cell = GeneratorCells.Find(ToCell(CurrentPos));
+		if (!Cell)
+		{
+			continue;
+		}
+
+		// 3. Queue a hole for every containing generator
+		for (const int32 GeneratorIndex : *Cell)
+		{
+			if (Subject.Generator.IsValid() && Subject.Generator != Generators[GeneratorIndex])
+			{
+				continue;
+			}
+
+			if (!GeneratorBounds[GeneratorIndex].IsInside(CurrentPos))
+			{
+				continue;
+			}
+
+			FIVSmokeHoleData& HoleData = PendingHoles[GeneratorIndex].AddDefaulted_GetRef();
+			HoleData.Position = LastPos;
+			HoleData.EndPosition = CurrentPos;
+			HoleData.PresetID = Subject.PresetID;
+			HoleData.ExpirationServerTime = CurrentTime + Preset->Duration;
+		}
+	}
+
+	// 3. One batch per generator
+	for (int32 GeneratorIndex = 0; GeneratorIndex < Generators.Num(); ++GeneratorIndex)
+	{
+		if (PendingHoles[GeneratorIndex].Num() > 0)
+		{
+			Generators[GeneratorIndex]->CreateDynamicHoles(PendingHoles[GeneratorIndex]);
+			PendingHoles[GeneratorIndex].Reset();
+		}
+	}
+}
+
+void UIVSmokeHoleTrackerSubsystem::RebuildGeneratorCells()
+{
+	Generators.RemoveAllSwap([](const TWeakObjectPtr<UIVSmokeHoleGeneratorComponent>& Generator) { return !Generator.IsValid(); });
+
+	GeneratorCells.Reset();
+	GeneratorBounds.SetNum(Generators.Num());
+	PendingHoles.SetNum(Generators.Num());
+
+	for (int32 GeneratorIndex = 0; GeneratorIndex < Generators.Num(); ++GeneratorIndex)
+	{
+		const FBox3f Box = FBox3f(Generators[GeneratorIndex]->Bounds.GetBox());
+		GeneratorBounds[GeneratorIndex] = Box;
+
+		const FIntVector MinCell = ToCell(Box.Min);
+		const FIntVector MaxCell = ToCell(Box.Max);
+		for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+				{
+					GeneratorCells.FindOrAdd(FIntVector(X, Y, Z)).Add(GeneratorIndex);
+				}
+			}
+		}
+	}
+}
+
+//~============================================================================
+// Public API
+#pragma region API
+void UIVSmokeHoleTrackerSubsystem::RegisterGenerator(UIVSmokeHoleGeneratorComponent* Generator)
+{
+	if (Generator)
+	{
+		Generators.AddUnique(Generator);
+	}
+}
+
+void UIVSmokeHoleTrackerSubsystem::UnregisterGenerator(UIVSmokeHoleGeneratorComponent* Generator)
+{
+	Generators.RemoveSwap(Generator);
+	UnregisterSubjects(Generator);
+}
+
+bool UIVSmokeHoleTrackerSubsystem::RegisterSubject(AActor* TargetActor, UIVSmokeHolePreset* Preset, UIVSmokeHoleGeneratorComponent* Generator)
+{
+	if (!TargetActor)
+	{
+		UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleTrackerSubsystem::RegisterSubject] TargetActor is null"));
+		return false;
+	}
+
+	if (!Preset || Preset->HoleType != EIVSmokeHoleType::Dynamic)
+	{
+		UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleTrackerSubsystem::RegisterSubject] Preset is not Dynamic type"));
+		return false;
+	}
+
+	// 1. Check if already registered
+	for (const FIVSmokeHoleDynamicSubject& Subject : Subjects)
+	{
+		if (Subject.TargetActor == TargetActor && Subject.Generator == Generator)
+		{
+			UE_LOG(LogIVSmoke, Warning, TEXT("[UIVSmokeHoleTrackerSubsystem::RegisterSubject] Actor already registered"));
+			return false;
+		}
+	}
+
+	// 2. Register new subject
+	FIVSmokeHoleDynamicSubject& NewDynamicSubject = Subjects.AddDefaulted_GetRef();
+	NewDynamicSubject.TargetActor = TargetActor;
+	NewDynamicSubject.Generator = Generator;
+	NewDynamicSubject.PresetID = Preset->GetPresetID();
+	NewDynamicSubject.LastWorldPosition = FVector3f(TargetActor->GetActorLocation());
+	NewDynamicSubject.LastWorldRotation = TargetActor->GetActorQuat();
+	return true;
+}
+
+void UIVSmokeHoleTrackerSubsystem::UnregisterSubject(AActor* TargetActor, UIVSmokeHoleGeneratorComponent* Generator)
+{
+	Subjects.RemoveAllSwap([TargetActor, Generator](const FIVSmokeHoleDynamicSubject& Subject)
+	{
+		return Subject.TargetActor == TargetActor && (!Generator || Subject.Generator == Generator);
+	});
+}
+
+void UIVSmokeHoleTrackerSubsystem::UnregisterSubjects(const UIVSmokeHoleGeneratorComponent* Generator)
+{
+	if (!Generator)
+	{
+		return;
+	}
+
+	Subjects.RemoveAllSwap([Generator](const FIVSmokeHoleDynamicSubject& Subject)
+	{
+		return Subject.Generator == Generator;
+	});
+}
+#pragma endregion
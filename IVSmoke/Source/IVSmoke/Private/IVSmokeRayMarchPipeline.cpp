@@ -15,6 +15,7 @@
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeTileSetupCS, "/Plugin/IVSmoke/IVSmokeTileSetupCS.usf", "MainCS", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeOccupancyBuildCS, "/Plugin/IVSmoke/IVSmokeOccupancyBuildCS.usf", "MainCS", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeMultiVolumeRayMarchCS, "/Plugin/IVSmoke/IVSmokeMultiVolumeRayMarch.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FIVSmokeLightTransmittanceCS, "/Plugin/IVSmoke/IVSmokeLightTransmittanceCS.usf", "MainCS", SF_Compute);
 
 //~==============================================================================
 // Occupancy Renderer Implementation
@@ -13,8 +13,11 @@
 #include "Engine/TextureRenderTargetVolume.h"
 #include "PostProcess/PostProcessMaterialInputs.h"
 #include "SceneRenderTargetParameters.h"
+#include "IVSmokeHoleAtlas.h"
 #include "IVSmokeHoleGeneratorComponent.h"
+#include "IVSmokeVoxelAtlas.h"
 #include "RenderGraphUtils.h"
+#include "Async/ParallelFor.h"
 #include "Engine/DirectionalLight.h"
 #include "Components/DirectionalLightComponent.h"
 #include "EngineUtils.h"
@@ -27,6 +30,7 @@
 #include "MaterialShaderType.h"
 #include "IVSmokeVisualMaterialPreset.h"
 #include "PixelShaderUtils.h"
+#include "SceneManagement.h"
 #include "FXRenderingUtils.h"  // For UE::FXRenderingUtils::GetRawViewRectUnsafe
 
 #if !UE_SERVER
@@ -71,10 +75,16 @@ void FIVSmokeRenderer::Shutdown()
 
 	// Clear View caches (RDG textures are only valid within frame, so just clear the map)
 	FrameViewCaches.Empty();
+	TemporalHistories.Empty();
+
+	DynamicResolutionStates.Empty();
+	TimestampQueryPool.SafeRelease();
+	RayMarchResolutionScale = 0.5f;
 
 	CleanupCSM();
+	ResetMainLightCache();
 }
-FIntVector FIVSmokeRenderer::GetAtlasTexCount(const FIntVector& TexSize, const int32 TexCount, const int32 TexturePackInterval, const int32 TexturePackMaxSize) const
+FIntVector FIVSmokeRenderer::GetAtlasTexCount(const FIntVector& TexSize, const int32 TexCount, const int32 TexturePackInterval, const int32 TexturePackMaxSize)
 {
 	int QuotientX = TexturePackMaxSize / (TexSize.X + TexturePackInterval);
 	int QuotientY = TexturePackMaxSize / (TexSize.Y + TexturePackInterval);
@@ -172,6 +182,31 @@ bool FIVSmokeRenderer::GetMainDirectionalLight(UWorld* World, FVector& OutDirect
 		return false;
 	}
 
+	FMainLightCache& Cache = FindOrAddMainLightCache(World);
+
+	// Search again only after an invalidation event or when the cached light was destroyed
+	UDirectionalLightComponent* MainLight = Cache.Light.Get();
+	if (Cache.bDirty || (!MainLight && !Cache.Light.IsExplicitlyNull()))
+	{
+		MainLight = FindMainDirectionalLight(World);
+		Cache.Light = MainLight;
+		Cache.bDirty = false;
+	}
+
+	if (MainLight)
+	{
+		// Negate: Shader expects direction TOWARD the light, not FROM the light
+		OutDirection = -MainLight->GetComponentRotation().Vector();
+		OutColor = MainLight->GetLightColor();
+		OutIntensity = MainLight->Intensity;
+		return true;
+	}
+
+	return false;
+}
+
+UDirectionalLightComponent* FIVSmokeRenderer::FindMainDirectionalLight(UWorld* World) const
+{
 	UDirectionalLightComponent* BestLight = nullptr;
 	int32 BestIndex = INT_MAX;
 
@@ -203,18 +238,93 @@ bool FIVSmokeRenderer::GetMainDirectionalLight(UWorld* World, FVector& OutDirect
 		}
 	}
 
-	if (BestLight)
+	return BestLight;
+}
+
+FIVSmokeRenderer::FMainLightCache& FIVSmokeRenderer::FindOrAddMainLightCache(UWorld* World)
+{
+	if (FMainLightCache* Cache = MainLightCaches.Find(World))
 	{
-		// Negate: Shader expects direction TOWARD the light, not FROM the light
-		OutDirection = -BestLight->GetComponentRotation().Vector();
-		OutColor = BestLight->GetLightColor();
-		OutIntensity = BestLight->Intensity;
-		return true;
+		return *Cache;
 	}
 
-	return false;
+	// Destroyed worlds (ended PIE sessions, unloaded editor maps) took their actor events with them
+	for (auto It = MainLightCaches.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	if (!LevelAddedHandle.IsValid())
+	{
+		LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FIVSmokeRenderer::OnMainLightLevelChanged);
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FIVSmokeRenderer::OnMainLightLevelChanged);
+#if WITH_EDITOR
+		LightPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FIVSmokeRenderer::OnMainLightPropertyChanged);
+#endif
+	}
+
+	FMainLightCache& Cache = MainLightCaches.Add(World);
+	Cache.ActorSpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateRaw(this, &FIVSmokeRenderer::OnMainLightActorChanged));
+	Cache.ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FIVSmokeRenderer::OnMainLightActorChanged));
+	return Cache;
+}
+
+void FIVSmokeRenderer::ResetMainLightCache()
+{
+	for (const TPair<TWeakObjectPtr<UWorld>, FMainLightCache>& Pair : MainLightCaches)
+	{
+		if (UWorld* World = Pair.Key.Get())
+		{
+			World->RemoveOnActorSpawnedHandler(Pair.Value.ActorSpawnedHandle);
+			World->RemoveOnActorDestroyededHandler(Pair.Value.ActorDestroyedHandle);
+		}
+	}
+	MainLightCaches.Empty();
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(LightPropertyChangedHandle);
+	LightPropertyChangedHandle.Reset();
+#endif
+	LevelAddedHandle.Reset();
+	LevelRemovedHandle.Reset();
+}
+
+void FIVSmokeRenderer::MarkMainLightDirty(const UWorld* World)
+{
+	if (FMainLightCache* Cache = World ? MainLightCaches.Find(World) : nullptr)
+	{
+		Cache->bDirty = true;
+	}
+}
+
+void FIVSmokeRenderer::OnMainLightActorChanged(AActor* Actor)
+{
+	if (Cast<ADirectionalLight>(Actor))
+	{
+		MarkMainLightDirty(Actor->GetWorld());
+	}
+}
+
+void FIVSmokeRenderer::OnMainLightLevelChanged(ULevel* Level, UWorld* World)
+{
+	MarkMainLightDirty(World);
 }
 
+#if WITH_EDITOR
+void FIVSmokeRenderer::OnMainLightPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (Cast<UDirectionalLightComponent>(Object) || Cast<ADirectionalLight>(Object))
+	{
+		MarkMainLightDirty(Object->GetWorld());
+	}
+}
+#endif
+
 void FIVSmokeRenderer::CreateNoiseVolume()
 {
 	constexpr int32 TexSize = FIVSmokeNoiseConfig::TexSize;
@@ -300,14 +410,15 @@ const UIVSmokeSmokePreset* FIVSmokeRenderer::GetEffectivePreset(const AIVSmokeVo
 //~==============================================================================
 // Thread-Safe Render Data Preparation
 
-FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmokeVoxelVolume*>& InVolumes, const FVector& CameraPosition)
+FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmokeVoxelVolume*>& InVolumes, const FVector& CameraPosition, const FMatrix& ProjectionMatrix)
 {
 	// Must be called on Game Thread
 	check(IsInGameThread());
 
 	FIVSmokePackedRenderData Result;
 
-	if (InVolumes.Num() == 0)
+	// Nested call from a CSM capture, the outer call owns this frame's slots and snapshot
+	if (InVolumes.Num() == 0 || bIsCapturingShadow)
 	{
 		return Result;
 	}
@@ -325,176 +436,192 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 	{
 		UE_LOG(LogIVSmoke, Log, TEXT("[FIVSmokeRenderer::PrepareRenderData] World changed. Cleaning up CSM and cached data."));
 		CleanupCSM();
-		CachedRenderData.Reset();
+		SetCachedRenderData(nullptr);
 		bServerTimeSynced = false;
 		LastRenderedWorld = CurrentWorld;
 	}
 
+	const UIVSmokeSettings* Settings = UIVSmokeSettings::Get();
+
+	//~==========================================================================
+	// Significance: rank volumes by projected screen area and opacity, most significant first
+	struct FRankedVolume
+	{
+		AIVSmokeVoxelVolume* Volume = nullptr;
+		float Significance = 0.0f;
+		float ScreenCoverage = 0.0f;
+	};
+	TArray<FRankedVolume> RankedVolumes;
+	RankedVolumes.Reserve(InVolumes.Num());
+	for (AIVSmokeVoxelVolume* Volume : InVolumes)
+	{
+		if (Volume)
+		{
+			FRankedVolume& Ranked = RankedVolumes.AddDefaulted_GetRef();
+			Ranked.Volume = Volume;
+			Ranked.Significance = ComputeVolumeSignificance(Volume, CameraPosition, ProjectionMatrix, Ranked.ScreenCoverage);
+		}
+	}
+	RankedVolumes.StableSort([](const FRankedVolume& A, const FRankedVolume& B)
+	{
+		return A.Significance > B.Significance;
+	});
+
 	// Filter volumes if exceeding maximum supported count
-	TArray<AIVSmokeVoxelVolume*> FilteredVolumes;
-	if (InVolumes.Num() > MaxSupportedVolumes)
+	if (RankedVolumes.Num() > MaxSupportedVolumes)
 	{
 		UE_LOG(LogIVSmoke, Warning,
 			TEXT("[FIVSmokeRenderer::PrepareRenderData] Volume count (%d) exceeds maximum (%d). "
-				 "Farthest volumes from camera will be excluded."),
-			InVolumes.Num(), MaxSupportedVolumes
+				 "Least significant volumes will be excluded."),
+			RankedVolumes.Num(), MaxSupportedVolumes
 		);
+		RankedVolumes.SetNum(MaxSupportedVolumes);
+	}
 
-		// Copy and sort by distance from camera (closest first)
-		FilteredVolumes = InVolumes;
-		FilteredVolumes.Sort([&CameraPosition](const AIVSmokeVoxelVolume& A, const AIVSmokeVoxelVolume& B)
+	// Fixed ray march budget: every volume marches at full quality while they cover at most VolumeStepBudget screens.
+	// Past the budget the least significant volumes give up samples first, then quality is scaled down as a whole.
+	const float StepBudget = Settings ? Settings->VolumeStepBudget : 2.0f;
+	const float MinStepQuality = Settings ? FMath::Clamp(Settings->MinVolumeStepQuality, 0.05f, 1.0f) : 0.25f;
+	const float MaxSignificance = RankedVolumes.Num() > 0 ? RankedVolumes[0].Significance : 0.0f;
+	TArray<AIVSmokeVoxelVolume*> VolumesToProcess;
+	TArray<float, TInlineAllocator<MaxSupportedVolumes>> StepQualities;
+	VolumesToProcess.Reserve(RankedVolumes.Num());
+	StepQualities.Reserve(RankedVolumes.Num());
+	float FullCoverage = 0.0f;
+	float SignificanceCoverage = 0.0f;
+	for (const FRankedVolume& Ranked : RankedVolumes)
+	{
+		const float SignificanceQuality = MaxSignificance > UE_KINDA_SMALL_NUMBER
+			? FMath::Lerp(MinStepQuality, 1.0f, Ranked.Significance / MaxSignificance)
+			: 1.0f;
+		VolumesToProcess.Add(Ranked.Volume);
+		StepQualities.Add(SignificanceQuality);
+		FullCoverage += Ranked.ScreenCoverage;
+		SignificanceCoverage += Ranked.ScreenCoverage * SignificanceQuality;
+	}
+	if (FullCoverage <= StepBudget)
+	{
+		for (float& StepQuality : StepQualities)
 		{
-			const float DistA = FVector::DistSquared(CameraPosition, A.GetActorLocation());
-			const float DistB = FVector::DistSquared(CameraPosition, B.GetActorLocation());
-			return DistA < DistB;
-		});
-
-		// Keep only the closest MaxSupportedVolumes
-		FilteredVolumes.SetNum(MaxSupportedVolumes);
+			StepQuality = 1.0f;
+		}
 	}
-
-	const TArray<AIVSmokeVoxelVolume*>& VolumesToProcess = (FilteredVolumes.Num() > 0) ? FilteredVolumes : InVolumes;
-
-	Result.VolumeCount = VolumesToProcess.Num();
-	Result.VolumeDataArray.Reserve(Result.VolumeCount);
-	Result.HoleTextures.Reserve(Result.VolumeCount);
-	Result.HoleTextureSizes.Reserve(Result.VolumeCount);
-
-	// Get resolution info from first valid volume
-	for (AIVSmokeVoxelVolume* Volume : VolumesToProcess)
+	else
 	{
-		if (Volume)
+		// Move from full quality towards the significance weighted quality only as far as the budget needs
+		const float Reduction = FullCoverage - SignificanceCoverage > UE_KINDA_SMALL_NUMBER
+			? FMath::Clamp((FullCoverage - StepBudget) / (FullCoverage - SignificanceCoverage), 0.0f, 1.0f)
+			: 1.0f;
+		for (float& StepQuality : StepQualities)
 		{
-			Result.VoxelResolution = Volume->GetGridResolution();
-			if (UIVSmokeHoleGeneratorComponent* HoleComp = Volume->GetHoleGeneratorComponent())
+			StepQuality = FMath::Lerp(1.0f, StepQuality, Reduction);
+		}
+
+		if (SignificanceCoverage > StepBudget)
+		{
+			const float BudgetScale = StepBudget / SignificanceCoverage;
+			for (float& StepQuality : StepQualities)
 			{
-				if (FTextureRHIRef HoleTex = HoleComp->GetHoleTextureRHI())
-				{
-					Result.HoleResolution = HoleTex->GetSizeXYZ();
-				}
+				StepQuality = FMath::Max(StepQuality * BudgetScale, MinStepQuality);
 			}
-			break;
 		}
 	}
 
-	// Fallback for hole resolution
-	if (Result.HoleResolution == FIntVector::ZeroValue)
+	// Switching the voxel data mode invalidates every slot, apply it before uploads are decided
+	FIVSmokeVoxelAtlas::Get().SetTimeAtlas(Settings && Settings->VoxelDataMode == EIVSmokeVoxelDataMode::TimeAtlas);
+
+	// Allocate every voxel atlas slot before uploading, a re-layout drops the contents of all slots
+	// Hole components are resolved here as well, the lookup caches on the volume and must not run on workers
+	TArray<int32, TInlineAllocator<MaxSupportedVolumes>> VolumeSlots;
+	TArray<const UIVSmokeHoleGeneratorComponent*, TInlineAllocator<MaxSupportedVolumes>> HoleComps;
+	VolumeSlots.Reserve(VolumesToProcess.Num());
+	HoleComps.Reserve(VolumesToProcess.Num());
+	for (AIVSmokeVoxelVolume* Volume : VolumesToProcess)
 	{
-		Result.HoleResolution = FIntVector(64, 64, 64);
+		VolumeSlots.Add(Volume ? FindOrAllocateVoxelAtlasSlot(Volume) : INDEX_NONE);
+		HoleComps.Add(Volume ? Volume->GetHoleGeneratorComponent() : nullptr);
 	}
 
-	// Calculate packed buffer sizes
-	const int32 TexturePackInterval = 4;
-	TArray<float> VoxelIntervalData;
-	VoxelIntervalData.Init(0, Result.VoxelResolution.X * Result.VoxelResolution.Y * TexturePackInterval);
+	// Each view family culls on its own, so a volume missing from this one may be rendered by the next.
+	// Slots are only freed once their volume is gone or has been culled everywhere for a while.
+	FreeUnusedVoxelAtlasSlots();
 
-	FIntVector VoxelAtlasResolution = FIntVector(
-		Result.VoxelResolution.X,
-		Result.VoxelResolution.Y,
-		Result.VoxelResolution.Z * Result.VolumeCount + TexturePackInterval * (Result.VolumeCount - 1)
-	);
-	int32 TotalVoxelSize = VoxelAtlasResolution.X * VoxelAtlasResolution.Y * VoxelAtlasResolution.Z;
-	Result.PackedVoxelBirthTimes.Reserve(TotalVoxelSize);
-	Result.PackedVoxelDeathTimes.Reserve(TotalVoxelSize);
+	// Read regions only once every slot is allocated, a re-pack moves the slots allocated before it
+	FIVSmokeVoxelAtlas& VoxelAtlas = FIVSmokeVoxelAtlas::Get();
+	TArray<FIVSmokeVoxelAtlasRegion, TInlineAllocator<MaxSupportedVolumes>> VolumeRegions;
+	VolumeRegions.Reserve(VolumesToProcess.Num());
+	for (const int32 VoxelAtlasSlot : VolumeSlots)
+	{
+		const FIVSmokeVoxelAtlasRegion Region = VoxelAtlas.GetRegion(VoxelAtlasSlot);
+		VolumeRegions.Add(Region);
+		Result.VoxelResolution = FIntVector(
+			FMath::Max(Result.VoxelResolution.X, Region.Resolution.X),
+			FMath::Max(Result.VoxelResolution.Y, Region.Resolution.Y),
+			FMath::Max(Result.VoxelResolution.Z, Region.Resolution.Z));
+	}
 
-	// Collect data from all volumes (Game Thread - safe to access)
+	//~==========================================================================
+	// Upload voxel data only when it changed or the slot lost its contents (new slot or atlas release).
+	// Uploads are ordered before any later render command, so the volume is clean once the copy is queued.
+	TArray<int32, TInlineAllocator<MaxSupportedVolumes>> UploadIndices;
 	for (int32 i = 0; i < VolumesToProcess.Num(); ++i)
 	{
 		AIVSmokeVoxelVolume* Volume = VolumesToProcess[i];
-		if (!Volume)
-		{
-			continue;
-		}
-
-		//~==========================================================================
-		// Copy VoxelArray data (Game Thread safe)
-		const TArray<float>& VoxelBirthTimes = Volume->GetVoxelBirthTimes();
-		Result.PackedVoxelBirthTimes.Append(VoxelBirthTimes);
-
-		const TArray<float>& VoxelDeathTimes = Volume->GetVoxelDeathTimes();
-		Result.PackedVoxelDeathTimes.Append(VoxelDeathTimes);
-
-		if (i < VolumesToProcess.Num() - 1)
+		if (Volume && VolumeSlots[i] != INDEX_NONE && (Volume->IsVoxelDataDirty() || !VoxelAtlas.IsSlotUploaded(VolumeSlots[i])))
 		{
-			Result.PackedVoxelBirthTimes.Append(VoxelIntervalData);
-			Result.PackedVoxelDeathTimes.Append(VoxelIntervalData);
+			UploadIndices.Add(i);
 		}
+	}
 
-		//~==========================================================================
-		// Hole Texture reference (RHI resources are thread-safe)
-		if (UIVSmokeHoleGeneratorComponent* HoleComp = Volume->GetHoleGeneratorComponent())
-		{
-			FTextureRHIRef HoleTex = HoleComp->GetHoleTextureRHI();
-			Result.HoleTextures.Add(HoleTex);
-			if (HoleTex)
-			{
-				Result.HoleTextureSizes.Add(HoleTex->GetSizeXYZ());
-			}
-			else
-			{
-				Result.HoleTextureSizes.Add(FIntVector::ZeroValue);
-			}
-		}
-		else
+	// Copy voxel arrays in parallel, render commands are then enqueued in order from the Game Thread.
+	// The copy has to finish before returning: the volumes keep writing these arrays in their next tick,
+	// so a task the render command waits on would race with the simulation.
+	TArray<TPair<TArray<float>, TArray<float>>, TInlineAllocator<MaxSupportedVolumes>> UploadData;
+	UploadData.SetNum(UploadIndices.Num());
+	ParallelFor(TEXT("IVSmoke.CopyVoxelData"), UploadIndices.Num(), 4, [&](const int32 UploadIndex)
+	{
+		const AIVSmokeVoxelVolume* Volume = VolumesToProcess[UploadIndices[UploadIndex]];
+		UploadData[UploadIndex].Key = Volume->GetVoxelBirthTimes();
+		UploadData[UploadIndex].Value = Volume->GetVoxelDeathTimes();
+	});
+	if (UploadIndices.Num() > 0)
+	{
+		++VoxelUploadGeneration;
+	}
+	for (int32 UploadIndex = 0; UploadIndex < UploadIndices.Num(); ++UploadIndex)
+	{
+		const int32 VolumeIndex = UploadIndices[UploadIndex];
+		VoxelAtlas.UploadSlot(VolumeSlots[VolumeIndex], MoveTemp(UploadData[UploadIndex].Key), MoveTemp(UploadData[UploadIndex].Value));
+		VolumesToProcess[VolumeIndex]->ClearVoxelDataDirty();
+
+		// Temporal history inside a changed volume is partially rejected
+		const FVector ChangedMin = VolumesToProcess[VolumeIndex]->GetVoxelWorldAABBMin();
+		const FVector ChangedMax = VolumesToProcess[VolumeIndex]->GetVoxelWorldAABBMax();
+		if (ChangedMin.X <= ChangedMax.X && ChangedMin.Y <= ChangedMax.Y && ChangedMin.Z <= ChangedMax.Z)
 		{
-			Result.HoleTextures.Add(nullptr);
-			Result.HoleTextureSizes.Add(FIntVector::ZeroValue);
+			Result.ChangedVolumeBounds.Add(FBox3f(FVector3f(ChangedMin), FVector3f(ChangedMax)));
 		}
+	}
 
-		//~==========================================================================
-		// Build GPU metadata
-		const FIntVector GridRes = Volume->GetGridResolution();
-		const FIntVector CenterOff = Volume->GetCenterOffset();
-		const float VoxelSz = Volume->GetVoxelSize();
-		const FTransform VolumeTransform = Volume->GetActorTransform();
-
-		// Calculate AABB
-		FVector HalfExtent = FVector(CenterOff) * VoxelSz;
-		FVector LocalMin = -HalfExtent;
-		FVector LocalMax = FVector(GridRes - CenterOff - FIntVector(1, 1, 1)) * VoxelSz;
-		FBox LocalBox(LocalMin, LocalMax);
-		FBox WorldBox = LocalBox.TransformBy(VolumeTransform);
-
-		// Get preset data
-		const UIVSmokeSmokePreset* Preset = GetEffectivePreset(Volume);
-
-		// Build GPU data struct
-		FIVSmokeVolumeGPUData GPUData;
-		FMemory::Memzero(&GPUData, sizeof(GPUData));
-
-		GPUData.VoxelSize = VoxelSz;
-		GPUData.VoxelBufferOffset = Result.VoxelResolution.X * Result.VoxelResolution.Y *
-			(Result.VoxelResolution.Z + TexturePackInterval) * i;
-		GPUData.GridResolution = FIntVector3(GridRes.X, GridRes.Y, GridRes.Z);
-		GPUData.VoxelCount = VoxelBirthTimes.Num();
-		GPUData.CenterOffset = FVector3f(CenterOff.X, CenterOff.Y, CenterOff.Z);
-		GPUData.VolumeWorldAABBMin = FVector3f(WorldBox.Min);
-		GPUData.VolumeWorldAABBMax = FVector3f(WorldBox.Max);
-		GPUData.VoxelWorldAABBMin = FVector3f(Volume->GetVoxelWorldAABBMin());
-		GPUData.VoxelWorldAABBMax = FVector3f(Volume->GetVoxelWorldAABBMax());
-		GPUData.FadeInDuration = Volume->FadeInDuration;
-		GPUData.FadeOutDuration = Volume->FadeOutDuration;
-
-		if (Preset)
-		{
-			GPUData.SmokeColor = FVector3f(Preset->SmokeColor.R, Preset->SmokeColor.G, Preset->SmokeColor.B);
-			GPUData.Absorption = Preset->SmokeAbsorption;
-			GPUData.DensityScale = Preset->VolumeDensity;
-		}
-		else
-		{
-			GPUData.SmokeColor = FVector3f(0.8f, 0.8f, 0.8f);
-			GPUData.Absorption = 0.1f;
-			GPUData.DensityScale = 1.0f;
-		}
+	//~==========================================================================
+	// Build GPU metadata in parallel, every volume writes only its own element.
+	// Synchronous as well: it reads actor transforms and presets, and the CSM fit and validity checks below consume it.
+	Result.VolumeDataArray.SetNumUninitialized(VolumesToProcess.Num());
+	ParallelFor(TEXT("IVSmoke.PackVolumeData"), VolumesToProcess.Num(), 8, [&](const int32 i)
+	{
+		Result.VolumeDataArray[i] = BuildVolumeGPUData(VolumesToProcess[i], HoleComps[i], VolumeSlots[i], VolumeRegions[i]);
+		Result.VolumeDataArray[i].StepQuality = StepQualities[i];
+	});
 
-		Result.VolumeDataArray.Add(GPUData);
-	}
+	// Drop volumes that could not get a voxel atlas slot, keeping the significance order
+	Result.VolumeDataArray.RemoveAll([](const FIVSmokeVolumeGPUData& GPUData)
+	{
+		return GPUData.VoxelAtlasSlot == INDEX_NONE;
+	});
+	Result.VolumeCount = Result.VolumeDataArray.Num();
 
 	//~==========================================================================
 	// Copy global settings parameters
-	const UIVSmokeSettings* Settings = UIVSmokeSettings::Get();
-
 	if (Settings)
 	{
 		// Post processing
@@ -502,6 +629,9 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 
 		// Ray marching
 		Result.MaxSteps = Settings->GetEffectiveMaxSteps();
+		Result.bEnableTemporalAccumulation = Settings->bEnableTemporalAccumulation;
+		Result.TemporalStepReduction = Settings->TemporalStepReduction;
+		Result.TemporalHistoryWeight = Settings->TemporalHistoryWeight;
 
 		// Appearance
 		Result.GlobalAbsorption = 0.1f;  // Default, per-volume absorption from preset
@@ -570,6 +700,7 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 		Result.LightMarchingDistance = Settings->LightMarchingDistance;
 		Result.LightMarchingExpFactor = Settings->LightMarchingExpFactor;
 		Result.ShadowAmbient = Settings->ShadowAmbient;
+		Result.bUseLightTransmittanceVolume = Settings->bUseLightTransmittanceVolume;
 
 		// External shadowing (CSM - Cascaded Shadow Maps)
 		// Note: CSM is always used when external shadowing is enabled. NumCascades > 0 indicates active.
@@ -616,12 +747,21 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 						}
 					}
 
+					// World bounds of the rendered volumes, cascades are fitted to them
+					TArray<FBox> SmokeBounds;
+					SmokeBounds.Reserve(Result.VolumeDataArray.Num());
+					for (const FIVSmokeVolumeGPUData& VolumeData : Result.VolumeDataArray)
+					{
+						SmokeBounds.Add(FBox(FVector(VolumeData.VolumeWorldAABBMin), FVector(VolumeData.VolumeWorldAABBMax)));
+					}
+
 					// Update CSM with current frame (includes synchronous capture)
 					CSMRenderer->Update(
 						CSMCameraPosition,
 						CSMCameraForward,
 						Result.LightDirection,
-						CurrentFrameNumber
+						CurrentFrameNumber,
+						SmokeBounds
 					);
 
 					bIsCapturingShadow = false;
@@ -647,7 +787,7 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 				for (int32 i = 0; i < Result.NumCascades; i++)
 				{
 					const FIVSmokeCascadeData& Cascade = CSMRenderer->GetCascade(i);
-					// Synchronous capture: VP matrix and texture are from the SAME frame
+					// Synchronous capture: VP matrix and texture are from the SAME capture (stale cascades keep both)
 					Result.CSMViewProjectionMatrices[i] = Cascade.ViewProjectionMatrix;
 					Result.CSMDepthTextures[i] = CSMRenderer->GetDepthTexture(i);
 					Result.CSMVSMTextures[i] = CSMRenderer->GetVSMTexture(i);
@@ -661,7 +801,7 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 		}
 	}
 
-	Result.bIsValid = Result.VolumeDataArray.Num() && Result.PackedVoxelBirthTimes.Num() > 0 && Result.PackedVoxelDeathTimes.Num() > 0;
+	Result.bIsValid = Result.VolumeDataArray.Num() > 0 && VoxelAtlas.GetLayout().IsValid();
 
 	if (VolumesToProcess.Num() > 0 && VolumesToProcess[0])
 	{
@@ -672,9 +812,170 @@ FIVSmokePackedRenderData FIVSmokeRenderer::PrepareRenderData(const TArray<AIVSmo
 		Result.GameTime = 0.0f;
 	}
 
+	// Light transmittance grids are rebuilt only when this key changes (or the light turns, see AddMultiVolumeRayMarchPass).
+	// Wind is not part of it, the grids are built from the unscrolled noise.
+	// Expansion/Dissipation fades (Expansion includes the fade in) and hole carving run on time, they step at a fixed interval.
+	bool bTimeAnimated = false;
+	uint32 DensityKey = VoxelUploadGeneration;
+	for (int32 i = 0; i < VolumesToProcess.Num(); ++i)
+	{
+		bTimeAnimated |= VolumesToProcess[i] && VolumesToProcess[i]->GetCurrentState() != EIVSmokeVoxelVolumeState::Sustain;
+		if (HoleComps[i])
+		{
+			bTimeAnimated |= HoleComps[i]->GetHoleAtlasSlot() != INDEX_NONE;
+			DensityKey = HashCombineFast(DensityKey, HoleComps[i]->GetHoleBufferGeneration());
+		}
+	}
+	if (bTimeAnimated)
+	{
+		DensityKey = HashCombineFast(DensityKey, (uint32)FMath::FloorToInt(Result.GameTime / LightTransmittanceAnimationInterval));
+	}
+	Result.LightTransmittanceDensityKey = DensityKey;
+
 	return Result;
 }
 
+FIVSmokeVolumeGPUData FIVSmokeRenderer::BuildVolumeGPUData(const AIVSmokeVoxelVolume* Volume, const UIVSmokeHoleGeneratorComponent* HoleComp, const int32 VoxelAtlasSlot, const FIVSmokeVoxelAtlasRegion& VoxelAtlasRegion) const
+{
+	FIVSmokeVolumeGPUData GPUData;
+	FMemory::Memzero(&GPUData, sizeof(GPUData));
+	GPUData.VoxelAtlasSlot = INDEX_NONE;
+	GPUData.StepQuality = 1.0f;
+	if (!Volume || VoxelAtlasSlot == INDEX_NONE || !VoxelAtlasRegion.IsValid())
+	{
+		return GPUData;
+	}
+
+	const FIntVector GridRes = Volume->GetGridResolution();
+	const FIntVector CenterOff = Volume->GetCenterOffset();
+	const float VoxelSz = Volume->GetVoxelSize();
+	const FTransform VolumeTransform = Volume->GetActorTransform();
+
+	// Calculate AABB
+	FVector HalfExtent = FVector(CenterOff) * VoxelSz;
+	FVector LocalMin = -HalfExtent;
+	FVector LocalMax = FVector(GridRes - CenterOff - FIntVector(1, 1, 1)) * VoxelSz;
+	FBox LocalBox(LocalMin, LocalMax);
+	FBox WorldBox = LocalBox.TransformBy(VolumeTransform);
+
+	// Get preset data
+	const UIVSmokeSmokePreset* Preset = GetEffectivePreset(Volume);
+
+	GPUData.VoxelSize = VoxelSz;
+	GPUData.VoxelBufferOffset = VoxelAtlasRegion.BufferOffset;
+	GPUData.GridResolution = FIntVector3(GridRes.X, GridRes.Y, GridRes.Z);
+	GPUData.VoxelCount = Volume->GetVoxelBufferSize();
+	GPUData.CenterOffset = FVector3f(CenterOff.X, CenterOff.Y, CenterOff.Z);
+	GPUData.VolumeWorldAABBMin = FVector3f(WorldBox.Min);
+	GPUData.VolumeWorldAABBMax = FVector3f(WorldBox.Max);
+	GPUData.VoxelWorldAABBMin = FVector3f(Volume->GetVoxelWorldAABBMin());
+	GPUData.VoxelWorldAABBMax = FVector3f(Volume->GetVoxelWorldAABBMax());
+	GPUData.FadeInDuration = Volume->FadeInDuration;
+	GPUData.FadeOutDuration = Volume->FadeOutDuration;
+	GPUData.HoleDistortionRange = HoleComp ? HoleComp->GetHoleDistortionRange() : 0.0f;
+	GPUData.HoleAtlasSlot = HoleComp ? HoleComp->GetHoleAtlasSlot() : INDEX_NONE;
+	GPUData.VoxelAtlasOffset = FIntVector3(VoxelAtlasRegion.AtlasOffset.X, VoxelAtlasRegion.AtlasOffset.Y, VoxelAtlasRegion.AtlasOffset.Z);
+	GPUData.VoxelAtlasSlot = VoxelAtlasSlot;
+
+	if (Preset)
+	{
+		GPUData.SmokeColor = FVector3f(Preset->SmokeColor.R, Preset->SmokeColor.G, Preset->SmokeColor.B);
+		GPUData.Absorption = Preset->SmokeAbsorption;
+		GPUData.DensityScale = Preset->VolumeDensity;
+	}
+	else
+	{
+		GPUData.SmokeColor = FVector3f(0.8f, 0.8f, 0.8f);
+		GPUData.Absorption = 0.1f;
+		GPUData.DensityScale = 1.0f;
+	}
+
+	return GPUData;
+}
+
+float FIVSmokeRenderer::ComputeVolumeSignificance(const AIVSmokeVoxelVolume* Volume, const FVector& CameraPosition, const FMatrix& ProjectionMatrix, float& OutScreenCoverage) const
+{
+	OutScreenCoverage = 0.0f;
+	const FVector BoundsMin = Volume->GetVoxelWorldAABBMin();
+	const FVector BoundsMax = Volume->GetVoxelWorldAABBMax();
+	if (BoundsMin.X > BoundsMax.X || BoundsMin.Y > BoundsMax.Y || BoundsMin.Z > BoundsMax.Z)
+	{
+		return 0.0f;
+	}
+
+	// Screen size is the bounding sphere diameter relative to the screen, its disc approximates the covered area
+	const FVector Extent = (BoundsMax - BoundsMin) * 0.5;
+	const FVector Origin = BoundsMin + Extent;
+	const float ScreenSize = ComputeBoundsScreenSize(Origin, Extent.Size(), CameraPosition, ProjectionMatrix);
+	OutScreenCoverage = FMath::Min(ScreenSize * ScreenSize * UE_PI * 0.25f, 1.0f);
+
+	// Opacity: how much of the bounds is filled with active voxels, scaled by the preset density
+	const double VoxelVolume = FMath::Cube((double)Volume->GetVoxelSize());
+	const FVector BoundsSize = BoundsMax - BoundsMin;
+	const double BoundsVolume = FMath::Max(BoundsSize.X * BoundsSize.Y * BoundsSize.Z, VoxelVolume);
+	const float Fill = FMath::Clamp((float)(Volume->GetActiveVoxelNum() * VoxelVolume / BoundsVolume), 0.0f, 1.0f);
+	const UIVSmokeSmokePreset* Preset = GetEffectivePreset(Volume);
+	const float Density = FMath::Clamp(Preset ? Preset->VolumeDensity : 1.0f, 0.0f, 1.0f);
+
+	return OutScreenCoverage * Fill * Density;
+}
+
+int32 FIVSmokeRenderer::FindOrAllocateVoxelAtlasSlot(const AIVSmokeVoxelVolume* Volume)
+{
+	FIVSmokeVoxelAtlas& VoxelAtlas = FIVSmokeVoxelAtlas::Get();
+	const TObjectKey<AIVSmokeVoxelVolume> VolumeKey(Volume);
+	const FIntVector GridResolution = Volume->GetGridResolution();
+	if (FVoxelAtlasSlotEntry* Entry = VoxelAtlasSlots.Find(VolumeKey))
+	{
+		if (VoxelAtlas.GetRegion(Entry->Slot).Resolution == GridResolution)
+		{
+			Entry->LastUsedFrame = GFrameNumber;
+			return Entry->Slot;
+		}
+
+		// Slots are sized to their volume, a resized volume needs a new one
+		VoxelAtlas.FreeSlot(Entry->Slot);
+		VoxelAtlasSlots.Remove(VolumeKey);
+	}
+
+	const int32 NewSlot = VoxelAtlas.AllocateSlot(GridResolution);
+	if (NewSlot != INDEX_NONE)
+	{
+		VoxelAtlasSlots.Add(VolumeKey, { NewSlot, GFrameNumber });
+		VoxelAtlasFailedVolumes.Remove(VolumeKey);
+	}
+	else if (!VoxelAtlasFailedVolumes.Contains(VolumeKey))
+	{
+		// Allocation is retried every frame, warn once until it succeeds
+		VoxelAtlasFailedVolumes.Add(VolumeKey);
+		UE_LOG(LogIVSmoke, Warning, TEXT("[FIVSmokeRenderer::FindOrAllocateVoxelAtlasSlot] No voxel atlas slot for %s (resolution %s, atlas %s bricks). The volume is not rendered."),
+			*Volume->GetName(), *GridResolution.ToString(), *VoxelAtlas.GetLayout().BrickCount.ToString());
+	}
+	return NewSlot;
+}
+
+void FIVSmokeRenderer::FreeUnusedVoxelAtlasSlots()
+{
+	for (auto It = VoxelAtlasSlots.CreateIterator(); It; ++It)
+	{
+		const bool bDestroyed = It.Key().ResolveObjectPtr() == nullptr;
+		const bool bExpired = GFrameNumber - It.Value().LastUsedFrame > VoxelAtlasSlotGraceFrames;
+		if (bDestroyed || bExpired)
+		{
+			FIVSmokeVoxelAtlas::Get().FreeSlot(It.Value().Slot);
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = VoxelAtlasFailedVolumes.CreateIterator(); It; ++It)
+	{
+		if (It->ResolveObjectPtr() == nullptr)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
 //~==============================================================================
 // Rendering
 
@@ -706,18 +1007,15 @@ FScreenPassTexture FIVSmokeRenderer::Render(
 	}
 
 	// Get cached render data (prepared on Game Thread via BeginRenderViewFamily)
-	// Use copy instead of MoveTemp - multiple views in same frame share the same data
-	FIVSmokePackedRenderData RenderData;
-	{
-		FScopeLock Lock(&RenderDataMutex);
-		RenderData = CachedRenderData;  // Copy - don't consume, other views may need it
-	}
+	// Multiple views in same frame share the same immutable snapshot
+	const FIVSmokeRenderDataSnapshot RenderDataSnapshot = GetCachedRenderData();
 
 	// Early out if no valid render data - avoid unnecessary texture allocations
-	if (!RenderData.bIsValid)
+	if (!RenderDataSnapshot.IsValid() || !RenderDataSnapshot->bIsValid)
 	{
 		return SceneColor;
 	}
+	const FIVSmokePackedRenderData& RenderData = *RenderDataSnapshot;
 
 	FScreenPassRenderTarget Output = Inputs.OverrideOutput;
 
@@ -871,7 +1169,8 @@ FRDGTextureRef FIVSmokeRenderer::AddUpsampleFilterPass(
 	FRDGTextureRef SmokeAlbedo,
 	FRDGTextureRef SmokeLocalPosAlpha,
 	const FIntPoint& TexSize,
-	const FIntPoint& ViewRectMin)
+	const FIntPoint& ViewRectMin,
+	const FVector2f& UpsampleRatio)
 {
 	FRDGTextureRef SmokeTex = FIVSmokePostProcessPass::CreateOutputTexture(
 		GraphBuilder,
@@ -891,6 +1190,7 @@ FRDGTextureRef FIVSmokeRenderer::AddUpsampleFilterPass(
 	Parameters->Sharpness = RenderData.Sharpness;
 	Parameters->ViewportSize = TexSize;
 	Parameters->ViewRectMin = FVector2f(ViewRectMin);
+	Parameters->UpsampleRatio = UpsampleRatio;
 	Parameters->RenderTargets[0] = FRenderTargetBinding(SmokeTex, ERenderTargetLoadAction::ENoAction);
 	FScreenPassRenderTarget Output(
 		SmokeTex,
@@ -979,148 +1279,158 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	//~==========================================================================
 	// Phase 0: Setup common resources (same as standard ray march)
 
-	const int32 TexturePackInterval = 4;
-	const int32 TexturePackMaxSize = 2048;
-	const FIntVector VoxelResolution = RenderData.VoxelResolution;
-	const FIntVector HoleResolution = RenderData.HoleResolution;
-	const FIntVector VoxelAtlasCount = GetAtlasTexCount(VoxelResolution, VolumeCount, TexturePackInterval, TexturePackMaxSize);
-	const FIntVector HoleAtlasCount = GetAtlasTexCount(HoleResolution, VolumeCount, TexturePackInterval, TexturePackMaxSize);
-
-	// Voxel Atlas: 3D packing
-	const FIntVector VoxelAtlasResolution = FIntVector(
-		VoxelResolution.X * VoxelAtlasCount.X + TexturePackInterval * (VoxelAtlasCount.X - 1),
-		VoxelResolution.Y * VoxelAtlasCount.Y + TexturePackInterval * (VoxelAtlasCount.Y - 1),
-		VoxelResolution.Z * VoxelAtlasCount.Z + TexturePackInterval * (VoxelAtlasCount.Z - 1)
-	);
-	const FIntVector VoxelAtlasFXAAResolution = VoxelAtlasResolution * 1;
-
-	// Hole Atlas: 3D packing
-	const FIntVector HoleAtlasResolution = FIntVector(
-		HoleResolution.X * HoleAtlasCount.X + TexturePackInterval * (HoleAtlasCount.X - 1),
-		HoleResolution.Y * HoleAtlasCount.Y + TexturePackInterval * (HoleAtlasCount.Y - 1),
-		HoleResolution.Z * HoleAtlasCount.Z + TexturePackInterval * (HoleAtlasCount.Z - 1)
-	);
-
-	// Create atlas textures
-	FRDGTextureDesc VoxelAtlasDesc = FRDGTextureDesc::Create3D(
-		VoxelAtlasResolution,
-		PF_R32_FLOAT,
-		FClearValueBinding::None,
-		TexCreate_ShaderResource | TexCreate_UAV
-	);
-	FRDGTextureRef PackedVoxelAtlas = GraphBuilder.CreateTexture(VoxelAtlasDesc, TEXT("IVSmoke_PackedVoxelAtlas"));
-
-	FRDGTextureDesc VoxelAtlasFXAAResDesc = FRDGTextureDesc::Create3D(
-		VoxelAtlasFXAAResolution,
-		PF_R32_FLOAT,
-		FClearValueBinding::None,
-		TexCreate_ShaderResource | TexCreate_UAV
-	);
-	FRDGTextureRef PackedVoxelAtlasFXAA = GraphBuilder.CreateTexture(VoxelAtlasFXAAResDesc, TEXT("IVSmoke_PackedVoxelAtlasFXAA"));
-
-	FRDGTextureDesc HoleAtlasDesc = FRDGTextureDesc::Create3D(
-		HoleAtlasResolution,
-		PF_FloatRGBA,
-		FClearValueBinding::None,
-		TexCreate_ShaderResource | TexCreate_UAV
-	);
-	FRDGTextureRef PackedHoleAtlas = GraphBuilder.CreateTexture(HoleAtlasDesc, TEXT("IVSmoke_PackedHoleAtlas"));
-
-	// Clear Hole Atlas with alpha = 1 (so density is not zeroed when HoleTexture is missing)
-	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(PackedHoleAtlas), FLinearColor(0.0f, 0.0f, 0.0f, 1.0f));
-
-	// Copy Hole Textures to Atlas
-	FRHICopyTextureInfo HoleCpyInfo;
-	HoleCpyInfo.Size = HoleResolution;
-	HoleCpyInfo.SourcePosition = FIntVector::ZeroValue;
-
-	for (int z = 0; z < HoleAtlasCount.Z; ++z)
+	// Voxel atlas persists across frames: birth/death times are only uploaded for dirty volumes,
+	// the density is re-evaluated every frame into each volume's stable slot (fade in/out depend on GameTime).
+	// In time atlas mode the ray march evaluates the fade itself and both atlas passes are skipped.
+	const int32 TexturePackInterval = FIVSmokeVoxelAtlas::SlotInterval;
+	FIVSmokeVoxelAtlas& VoxelAtlas = FIVSmokeVoxelAtlas::Get();
+	const FIVSmokeVoxelAtlasLayout& VoxelAtlasLayout = VoxelAtlas.GetLayout_RenderThread();
+	const bool bVoxelTimeAtlas = VoxelAtlasLayout.bTimeAtlas;
+	FRDGBufferRef BirthBuffer = nullptr;
+	FRDGBufferRef DeathBuffer = nullptr;
+	FRDGTextureRef PackedVoxelAtlas = nullptr;
+	FRDGTextureRef VoxelTimeAtlas = nullptr;
+	FRDGTextureRef VoxelMacroCellAtlas = nullptr;
+	if (bVoxelTimeAtlas)
 	{
-		for (int y = 0; y < HoleAtlasCount.Y; ++y)
+		VoxelTimeAtlas = VoxelAtlas.RegisterTimeAtlas(GraphBuilder, VoxelMacroCellAtlas);
+		if (!VoxelTimeAtlas)
 		{
-			for (int x = 0; x < HoleAtlasCount.X; ++x)
-			{
-				int i = x + HoleAtlasCount.X * y + z * HoleAtlasCount.X * HoleAtlasCount.Y;
-
-				if (i >= RenderData.HoleTextures.Num())
-				{
-					break;
-				}
-
-				FTextureRHIRef SourceRHI = RenderData.HoleTextures[i];
-				if (!SourceRHI)
-				{
-					continue;
-				}
+			return;
+		}
+	}
+	else
+	{
+		if (!VoxelAtlas.RegisterBuffers(GraphBuilder, BirthBuffer, DeathBuffer))
+		{
+			return;
+		}
+		PackedVoxelAtlas = VoxelAtlas.RegisterDensityAtlas(GraphBuilder);
+	}
 
-				FRDGTextureRef SourceTexture = GraphBuilder.RegisterExternalTexture(
-					CreateRenderTarget(SourceRHI, TEXT("IVSmoke_CopyHoleSource"))
-				);
+	const FIntVector VoxelResolution = RenderData.VoxelResolution;
+	const FIntVector VoxelAtlasResolution = VoxelAtlasLayout.GetAtlasResolution();
+	const FIntVector VoxelAtlasFXAAResolution = VoxelAtlasResolution * 1;
 
-				HoleCpyInfo.DestPosition.X = x * (HoleResolution.X + TexturePackInterval);
-				HoleCpyInfo.DestPosition.Y = y * (HoleResolution.Y + TexturePackInterval);
-				HoleCpyInfo.DestPosition.Z = z * (HoleResolution.Z + TexturePackInterval);
-				AddCopyTexturePass(GraphBuilder, SourceTexture, PackedHoleAtlas, HoleCpyInfo);
-			}
-		}
+	// Hole atlas persists across frames, hole generators carve directly into their slots.
+	// Compact masks carry distortion in a separate RGB10A2 atlas while any explosion is active.
+	static_assert(FIVSmokeHoleAtlas::SlotInterval == FIVSmokeVoxelAtlas::SlotInterval, "Hole atlas and voxel atlas share PackedInterval");
+	FIVSmokeHoleAtlas& HoleAtlas = FIVSmokeHoleAtlas::Get();
+	const FIVSmokeHoleAtlasLayout& HoleAtlasLayout = HoleAtlas.GetLayout_RenderThread();
+	FRDGTextureRef PackedHoleAtlas = HoleAtlas.RegisterMaskAtlas(GraphBuilder);
+	FRDGTextureRef PackedHoleDistortionAtlas = HoleAtlas.RegisterDistortionAtlas(GraphBuilder);
+	const bool bCompactHole = PackedHoleAtlas && HoleAtlasLayout.IsCompact();
+	const bool bHoleDistortionAtlas = bCompactHole && PackedHoleDistortionAtlas;
+	if (!PackedHoleAtlas)
+	{
+		// No hole generator has ever allocated a slot, every volume reads HoleAtlasSlot = INDEX_NONE
+		FRDGTextureDesc DummyHoleAtlasDesc = FRDGTextureDesc::Create3D(
+			FIntVector(1, 1, 1),
+			PF_FloatRGBA,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		PackedHoleAtlas = GraphBuilder.CreateTexture(DummyHoleAtlasDesc, TEXT("IVSmoke_HoleAtlasDummy"));
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(PackedHoleAtlas), FLinearColor(0.0f, 0.0f, 0.0f, 1.0f));
+	}
+	if (!bHoleDistortionAtlas)
+	{
+		PackedHoleDistortionAtlas = PackedHoleAtlas;
 	}
 
 	// Create GPU buffers
 	FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(View.FeatureLevel);
 
-	FRDGBufferDesc BirthBufferDesc = FRDGBufferDesc::CreateStructuredDesc(sizeof(float), RenderData.PackedVoxelBirthTimes.Num());
-	FRDGBufferRef BirthBuffer = GraphBuilder.CreateBuffer(BirthBufferDesc, TEXT("IVSmoke_PackedBirthBuffer"));
-	GraphBuilder.QueueBufferUpload(BirthBuffer, RenderData.PackedVoxelBirthTimes.GetData(), RenderData.PackedVoxelBirthTimes.Num() * sizeof(float));
-
-	FRDGBufferDesc DeathBufferDesc = FRDGBufferDesc::CreateStructuredDesc(sizeof(float), RenderData.PackedVoxelDeathTimes.Num());
-	FRDGBufferRef DeathBuffer = GraphBuilder.CreateBuffer(DeathBufferDesc, TEXT("IVSmoke_PackedDeathBuffer"));
-	GraphBuilder.QueueBufferUpload(DeathBuffer, RenderData.PackedVoxelDeathTimes.GetData(), RenderData.PackedVoxelDeathTimes.Num() * sizeof(float));
-
 	FRDGBufferDesc VolumeBufferDesc = FRDGBufferDesc::CreateStructuredDesc(sizeof(FIVSmokeVolumeGPUData), RenderData.VolumeDataArray.Num());
 	FRDGBufferRef VolumeBuffer = GraphBuilder.CreateBuffer(VolumeBufferDesc, TEXT("IVSmokeVolumeDataBuffer"));
 	GraphBuilder.QueueBufferUpload(VolumeBuffer, RenderData.VolumeDataArray.GetData(), RenderData.VolumeDataArray.Num() * sizeof(FIVSmokeVolumeGPUData));
 
-	// StructuredToTexture Pass
-	TShaderMapRef<FIVSmokeStructuredToTextureCS> StructuredCopyShader(ShaderMap);
-	auto* StructuredCopyParams = GraphBuilder.AllocParameters<FIVSmokeStructuredToTextureCS::FParameters>();
-	StructuredCopyParams->Desti = GraphBuilder.CreateUAV(PackedVoxelAtlas);
-	StructuredCopyParams->BirthTimes = GraphBuilder.CreateSRV(BirthBuffer);
-	StructuredCopyParams->DeathTimes = GraphBuilder.CreateSRV(DeathBuffer);
-	StructuredCopyParams->VolumeDataBuffer = GraphBuilder.CreateSRV(VolumeBuffer);
-	StructuredCopyParams->TexSize = VoxelAtlasResolution;
-	StructuredCopyParams->VoxelResolution = RenderData.VoxelResolution;
-	StructuredCopyParams->PackedInterval = TexturePackInterval;
-	StructuredCopyParams->VoxelAtlasCount = VoxelAtlasCount;
-	StructuredCopyParams->GameTime = RenderData.GameTime;
-	StructuredCopyParams->VolumeCount = VolumeCount;
-
-	FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeStructuredToTextureCS>(
-		GraphBuilder,
-		ShaderMap,
-		StructuredCopyShader,
-		StructuredCopyParams,
-		VoxelAtlasResolution
-	);
+	FRDGTextureRef PackedVoxelAtlasFXAA = nullptr;
+	if (!bVoxelTimeAtlas)
+	{
+		FRDGTextureDesc VoxelAtlasFXAAResDesc = FRDGTextureDesc::Create3D(
+			VoxelAtlasFXAAResolution,
+			PF_R32_FLOAT,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		PackedVoxelAtlasFXAA = GraphBuilder.CreateTexture(VoxelAtlasFXAAResDesc, TEXT("IVSmoke_PackedVoxelAtlasFXAA"));
+
+		// StructuredToTexture Pass
+		TShaderMapRef<FIVSmokeStructuredToTextureCS> StructuredCopyShader(ShaderMap);
+		auto* StructuredCopyParams = GraphBuilder.AllocParameters<FIVSmokeStructuredToTextureCS::FParameters>();
+		StructuredCopyParams->Desti = GraphBuilder.CreateUAV(PackedVoxelAtlas);
+		StructuredCopyParams->BirthTimes = GraphBuilder.CreateSRV(BirthBuffer);
+		StructuredCopyParams->DeathTimes = GraphBuilder.CreateSRV(DeathBuffer);
+		StructuredCopyParams->VolumeDataBuffer = GraphBuilder.CreateSRV(VolumeBuffer);
+		StructuredCopyParams->VoxelResolution = VoxelResolution;
+		StructuredCopyParams->PackedInterval = TexturePackInterval;
+		StructuredCopyParams->GameTime = RenderData.GameTime;
+		StructuredCopyParams->VolumeCount = VolumeCount;
+
+		FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeStructuredToTextureCS>(
+			GraphBuilder,
+			ShaderMap,
+			StructuredCopyShader,
+			StructuredCopyParams,
+			FIntVector(
+				VoxelResolution.X + TexturePackInterval * 2,
+				VoxelResolution.Y + TexturePackInterval * 2,
+				(VoxelResolution.Z + TexturePackInterval * 2) * VolumeCount)
+		);
 
-	// Voxel FXAA Pass
-	TShaderMapRef<FIVSmokeVoxelFXAACS> VoxelFXAAShader(ShaderMap);
-	auto* VoxelFXAAParams = GraphBuilder.AllocParameters<FIVSmokeVoxelFXAACS::FParameters>();
+		// Voxel FXAA Pass
+		TShaderMapRef<FIVSmokeVoxelFXAACS> VoxelFXAAShader(ShaderMap);
+		auto* VoxelFXAAParams = GraphBuilder.AllocParameters<FIVSmokeVoxelFXAACS::FParameters>();
 
-	VoxelFXAAParams->Desti = GraphBuilder.CreateUAV(PackedVoxelAtlasFXAA);
-	VoxelFXAAParams->Source = GraphBuilder.CreateSRV(PackedVoxelAtlas);
-	VoxelFXAAParams->LinearBorder_Sampler = TStaticSamplerState<SF_Bilinear, AM_Border, AM_Border, AM_Border>::GetRHI();
-	VoxelFXAAParams->TexSize = VoxelAtlasFXAAResolution;
-	VoxelFXAAParams->FXAASpanMax = Settings->FXAASpanMax;
-	VoxelFXAAParams->FXAARange = Settings->FXAARange;
-	VoxelFXAAParams->FXAASharpness = Settings->FXAASharpness;
+		VoxelFXAAParams->Desti = GraphBuilder.CreateUAV(PackedVoxelAtlasFXAA);
+		VoxelFXAAParams->Source = GraphBuilder.CreateSRV(PackedVoxelAtlas);
+		VoxelFXAAParams->LinearBorder_Sampler = TStaticSamplerState<SF_Bilinear, AM_Border, AM_Border, AM_Border>::GetRHI();
+		VoxelFXAAParams->TexSize = VoxelAtlasFXAAResolution;
+		VoxelFXAAParams->FXAASpanMax = Settings->FXAASpanMax;
+		VoxelFXAAParams->FXAARange = Settings->FXAARange;
+		VoxelFXAAParams->FXAASharpness = Settings->FXAASharpness;
 
-	FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeVoxelFXAACS>(
-		GraphBuilder,
-		ShaderMap,
-		VoxelFXAAShader,
-		VoxelFXAAParams,
-		VoxelAtlasFXAAResolution
-	);
+		FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeVoxelFXAACS>(
+			GraphBuilder,
+			ShaderMap,
+			VoxelFXAAShader,
+			VoxelFXAAParams,
+			VoxelAtlasFXAAResolution
+		);
+	}
+
+	// Empty space skipping inside volumes. Edge noise reaches into empty voxels when its fade offset is negative.
+	// The time atlas keeps its macro cells up to date on upload, the density atlas changes every frame.
+	const bool bUseMacroCells = Settings->bEnableMacroCellSkipping && RenderData.VolumeEdgeNoiseFadeOffset >= 0.0f;
+	if (bUseMacroCells && !bVoxelTimeAtlas)
+	{
+		FRDGTextureDesc MacroCellDesc = FRDGTextureDesc::Create3D(
+			VoxelAtlasLayout.GetMacroCellResolution(),
+			PF_R32_FLOAT,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		VoxelMacroCellAtlas = GraphBuilder.CreateTexture(MacroCellDesc, TEXT("IVSmoke_VoxelMacroCellAtlas"));
+
+		// Macro Cell Build Pass, one block per volume like StructuredToTexture
+		const FIntVector MacroCellCount = FIntVector::DivideAndRoundUp(VoxelResolution, FIVSmokeVoxelAtlas::MacroCellSize);
+		TShaderMapRef<FIVSmokeMacroCellBuildCS> MacroCellBuildShader(ShaderMap);
+		auto* MacroCellBuildParams = GraphBuilder.AllocParameters<FIVSmokeMacroCellBuildCS::FParameters>();
+		MacroCellBuildParams->Desti = GraphBuilder.CreateUAV(VoxelMacroCellAtlas);
+		MacroCellBuildParams->Source = GraphBuilder.CreateSRV(PackedVoxelAtlasFXAA);
+		MacroCellBuildParams->VolumeDataBuffer = GraphBuilder.CreateSRV(VolumeBuffer);
+		MacroCellBuildParams->MacroCellCount = MacroCellCount;
+		MacroCellBuildParams->VolumeCount = VolumeCount;
+
+		FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeMacroCellBuildCS>(
+			GraphBuilder,
+			ShaderMap,
+			MacroCellBuildShader,
+			MacroCellBuildParams,
+			FIntVector(MacroCellCount.X, MacroCellCount.Y, MacroCellCount.Z * VolumeCount)
+		);
+	}
 
 	//~==========================================================================
 	// Phase 1: Create Occupancy Resources
@@ -1189,8 +1499,13 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	//~==========================================================================
 	// Phase 4: Pass 2 - Ray March with Occupancy
 
-	TShaderMapRef<FIVSmokeMultiVolumeRayMarchCS> ComputeShader(ShaderMap);
+	FIVSmokeMultiVolumeRayMarchCS::FPermutationDomain RayMarchPermutation;
+	RayMarchPermutation.Set<FIVSmokeMultiVolumeRayMarchCS::FCompactHoleDim>(bCompactHole);
+	RayMarchPermutation.Set<FIVSmokeMultiVolumeRayMarchCS::FHoleDistortionDim>(!bCompactHole || bHoleDistortionAtlas);
+	RayMarchPermutation.Set<FIVSmokeMultiVolumeRayMarchCS::FVoxelTimeAtlasDim>(bVoxelTimeAtlas);
+	TShaderMapRef<FIVSmokeMultiVolumeRayMarchCS> ComputeShader(ShaderMap, RayMarchPermutation);
 	auto* Parameters = GraphBuilder.AllocParameters<FIVSmokeMultiVolumeRayMarchCS::FParameters>();
+	FIVSmokeDensitySamplingParameters& Density = Parameters->Density;
 
 	// Output (Dual Render Target)
 	Parameters->SmokeAlbedoTex = GraphBuilder.CreateUAV(FRDGTextureUAVDesc(SmokeAlbedoTex));
@@ -1212,16 +1527,16 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	FRDGTextureRef NoiseVolumeRDG = GraphBuilder.RegisterExternalTexture(
 		CreateRenderTarget(TextureRHI, TEXT("IVSmokeNoiseVolume"))
 	);
-	Parameters->NoiseVolume = NoiseVolumeRDG;
-	Parameters->NoiseUVMul = FIVSmokeNoiseConfig::NoiseUVMul;
+	Density.NoiseVolume = NoiseVolumeRDG;
+	Density.NoiseUVMul = FIVSmokeNoiseConfig::NoiseUVMul;
 
 	// Sampler
-	Parameters->LinearBorder_Sampler = TStaticSamplerState<SF_Trilinear, AM_Border, AM_Border, AM_Border>::GetRHI();
-	Parameters->LinearRepeat_Sampler = TStaticSamplerState<SF_Trilinear, AM_Wrap, AM_Wrap, AM_Wrap>::GetRHI();
+	Density.LinearBorder_Sampler = TStaticSamplerState<SF_Trilinear, AM_Border, AM_Border, AM_Border>::GetRHI();
+	Density.LinearRepeat_Sampler = TStaticSamplerState<SF_Trilinear, AM_Wrap, AM_Wrap, AM_Wrap>::GetRHI();
 
 	// Time
-	//Parameters->ElapsedTime = View.Family->Time.GetRealTimeSeconds();
-	Parameters->ElapsedTime = View.Family->Time.GetRealTimeSeconds() + ServerTimeOffset;
+	//Density.ElapsedTime = View.Family->Time.GetRealTimeSeconds();
+	Density.ElapsedTime = View.Family->Time.GetRealTimeSeconds() + ServerTimeOffset;
 
 	// Viewport
 	Parameters->TexSize = FIntPoint(TexSize.X, TexSize.Y);
@@ -1240,23 +1555,36 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	Parameters->AspectRatio = (float)ViewportSize.X / (float)ViewportSize.Y;
 
 	// Ray Marching
-	Parameters->MaxSteps = RenderData.MaxSteps;
-	Parameters->MinStepSize = MinStepSize;
+	// Temporal accumulation spreads the samples over frames: fewer, longer steps, the per-frame jitter fills the gaps
+	const float TemporalStepReduction = RenderData.bEnableTemporalAccumulation ? FMath::Max(RenderData.TemporalStepReduction, 1.0f) : 1.0f;
+	Parameters->MaxSteps = FMath::Max(1, FMath::RoundToInt(RenderData.MaxSteps / TemporalStepReduction));
+	Parameters->MinStepSize = MinStepSize * TemporalStepReduction;
 
 	// Volume Data Buffer
-	Parameters->VolumeDataBuffer = GraphBuilder.CreateSRV(VolumeBuffer);
+	Density.VolumeDataBuffer = GraphBuilder.CreateSRV(VolumeBuffer);
 	Parameters->NumActiveVolumes = RenderData.VolumeDataArray.Num();
 
 	// Packed Textures
-	Parameters->PackedInterval = TexturePackInterval;
-	Parameters->PackedVoxelAtlas = GraphBuilder.CreateSRV(PackedVoxelAtlasFXAA);
-	Parameters->VoxelTexSize = VoxelResolution;
-	Parameters->PackedVoxelTexSize = VoxelAtlasResolution;
-	Parameters->VoxelAtlasCount = VoxelAtlasCount;
-	Parameters->PackedHoleAtlas = GraphBuilder.CreateSRV(PackedHoleAtlas);
-	Parameters->HoleTexSize = HoleResolution;
-	Parameters->PackedHoleTexSize = HoleAtlasResolution;
-	Parameters->HoleAtlasCount = HoleAtlasCount;
+	Density.PackedInterval = TexturePackInterval;
+	if (bVoxelTimeAtlas)
+	{
+		Density.VoxelTimeAtlas = GraphBuilder.CreateSRV(VoxelTimeAtlas);
+		Density.GameTime = RenderData.GameTime;
+	}
+	else
+	{
+		Density.PackedVoxelAtlas = GraphBuilder.CreateSRV(PackedVoxelAtlasFXAA);
+	}
+	// Without macro cells the parameter only needs a texture of the matching format
+	Parameters->bUseMacroCells = bUseMacroCells && VoxelMacroCellAtlas ? 1 : 0;
+	Parameters->VoxelMacroCellAtlas = GraphBuilder.CreateSRV(
+		Parameters->bUseMacroCells ? VoxelMacroCellAtlas : (bVoxelTimeAtlas ? VoxelTimeAtlas : PackedVoxelAtlasFXAA));
+	Density.PackedVoxelTexSize = VoxelAtlasResolution;
+	Density.PackedHoleAtlas = GraphBuilder.CreateSRV(PackedHoleAtlas);
+	Density.PackedHoleDistortionAtlas = GraphBuilder.CreateSRV(PackedHoleDistortionAtlas);
+	Density.HoleTexSize = HoleAtlasLayout.IsValid() ? HoleAtlasLayout.SlotResolution : FIntVector(1, 1, 1);
+	Density.PackedHoleTexSize = HoleAtlasLayout.IsValid() ? HoleAtlasLayout.GetAtlasResolution() : FIntVector(1, 1, 1);
+	Density.HoleAtlasCount = HoleAtlasLayout.SlotCount;
 
 	// Scene Textures
 	Parameters->SceneTexturesStruct = GetSceneTextureShaderParameters(View).SceneTextures;
@@ -1289,11 +1617,11 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 
 	// Global Smoke Parameters
 	Parameters->GlobalAbsorption = RenderData.GlobalAbsorption;
-	Parameters->SmokeSize = RenderData.SmokeSize;
-	Parameters->WindDirection = FVector3f(RenderData.WindDirection);
-	Parameters->VolumeRangeOffset = RenderData.VolumeRangeOffset;
-	Parameters->VolumeEdgeNoiseFadeOffset = RenderData.VolumeEdgeNoiseFadeOffset;
-	Parameters->VolumeEdgeFadeSharpness = RenderData.VolumeEdgeFadeSharpness;
+	Density.SmokeSize = RenderData.SmokeSize;
+	Density.WindDirection = FVector3f(RenderData.WindDirection);
+	Density.VolumeRangeOffset = RenderData.VolumeRangeOffset;
+	Density.VolumeEdgeNoiseFadeOffset = RenderData.VolumeEdgeNoiseFadeOffset;
+	Density.VolumeEdgeFadeSharpness = RenderData.VolumeEdgeFadeSharpness;
 
 	// Rayleigh Scattering
 	Parameters->LightDirection = FVector3f(RenderData.LightDirection);
@@ -1307,6 +1635,66 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	Parameters->LightMarchingExpFactor = RenderData.LightMarchingExpFactor;
 	Parameters->ShadowAmbient = RenderData.ShadowAmbient;
 
+	// Light Transmittance Atlas: every volume's grid is swept only when voxels, holes or fade steps change the density
+	// or the light turns past the threshold. All views and frames in between reuse the kept grids.
+	const bool bUseLightTransmittance = RenderData.bEnableSelfShadowing && RenderData.LightMarchingSteps > 0 && RenderData.bUseLightTransmittanceVolume;
+	const FIntVector LightTransmittanceAtlasResolution = FIVSmokeLightTransmittanceConfig::GetAtlasResolution(bUseLightTransmittance ? VolumeCount : 1);
+	const FVector3f LightTransmittanceLightDir = FVector3f(RenderData.LightDirection).GetSafeNormal();
+	const uint32 LightTransmittanceHash = bUseLightTransmittance ? ComputeLightTransmittanceInputHash(RenderData, bVoxelTimeAtlas) : 0;
+	const bool bReuseLightTransmittance = bUseLightTransmittance
+		&& LightTransmittanceAtlasRT.IsValid()
+		&& LightTransmittanceAtlasRT->GetDesc().GetSize() == LightTransmittanceAtlasResolution
+		&& LightTransmittanceInputHash == LightTransmittanceHash
+		&& FVector3f::DotProduct(LightTransmittanceLightDirection, LightTransmittanceLightDir) >= LightTransmittanceLightCosThreshold;
+	if (!bUseLightTransmittance)
+	{
+		LightTransmittanceAtlasRT.SafeRelease();
+	}
+
+	FRDGTextureRef LightTransmittanceAtlas = bReuseLightTransmittance
+		? GraphBuilder.RegisterExternalTexture(LightTransmittanceAtlasRT, TEXT("IVSmoke_LightTransmittanceAtlas"))
+		: GraphBuilder.CreateTexture(
+			FRDGTextureDesc::Create3D(
+				LightTransmittanceAtlasResolution,
+				PF_R16F,
+				FClearValueBinding::None,
+				TexCreate_ShaderResource | TexCreate_UAV
+			),
+			TEXT("IVSmoke_LightTransmittanceAtlas")
+		);
+	if (bUseLightTransmittance && !bReuseLightTransmittance)
+	{
+		TShaderMapRef<FIVSmokeLightTransmittanceCS> LightTransmittanceShader(ShaderMap, RayMarchPermutation);
+		auto* LightTransmittanceParams = GraphBuilder.AllocParameters<FIVSmokeLightTransmittanceCS::FParameters>();
+		LightTransmittanceParams->LightTransmittanceAtlasRW = GraphBuilder.CreateUAV(LightTransmittanceAtlas);
+		LightTransmittanceParams->Density = Density;
+		// Unscrolled noise, the grids stay valid while the wind moves the noise. Its detail is below the grid resolution anyway.
+		LightTransmittanceParams->Density.ElapsedTime = 0.0f;
+		LightTransmittanceParams->NumActiveVolumes = VolumeCount;
+		LightTransmittanceParams->GlobalAbsorption = RenderData.GlobalAbsorption;
+		LightTransmittanceParams->LightDirection = LightTransmittanceLightDir;
+
+		FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeLightTransmittanceCS>(
+			GraphBuilder,
+			ShaderMap,
+			LightTransmittanceShader,
+			LightTransmittanceParams,
+			FIntVector(FIVSmokeLightTransmittanceConfig::Resolution, FIVSmokeLightTransmittanceConfig::Resolution, VolumeCount)
+		);
+
+		LightTransmittanceAtlasRT = GraphBuilder.ConvertToExternalTexture(LightTransmittanceAtlas);
+		LightTransmittanceInputHash = LightTransmittanceHash;
+		LightTransmittanceLightDirection = LightTransmittanceLightDir;
+	}
+	else if (!bUseLightTransmittance)
+	{
+		// Light marching path, the parameter only needs a texture
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(LightTransmittanceAtlas), FLinearColor::White);
+	}
+	Parameters->LightTransmittanceAtlas = GraphBuilder.CreateSRV(LightTransmittanceAtlas);
+	Parameters->LightTransmittanceAtlasInvSize = FVector3f(1.0f) / FVector3f(LightTransmittanceAtlasResolution);
+	Parameters->bUseLightTransmittance = bUseLightTransmittance ? 1 : 0;
+
 	// Global AABB for per-pixel light march distance calculation
 	Parameters->GlobalAABBMin = GlobalAABBMin;
 	Parameters->GlobalAABBMax = GlobalAABBMax;
@@ -1467,7 +1855,8 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	Parameters->FrameNumber = View.Family->FrameNumber;
 	Parameters->JitterIntensity = 1.0f;
 
-	// Dispatch
+	// Dispatch. Only the ray march itself scales with TexSize, the per-volume passes above are timed as fixed cost.
+	AddPrePassTimestamp(GraphBuilder, View, EPrePassTimestamp::ScaledBegin);
 	FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeMultiVolumeRayMarchCS>(
 		GraphBuilder,
 		ShaderMap,
@@ -1477,6 +1866,123 @@ void FIVSmokeRenderer::AddMultiVolumeRayMarchPass(
 	);
 }
 
+uint32 FIVSmokeRenderer::ComputeLightTransmittanceInputHash(const FIVSmokePackedRenderData& RenderData, bool bVoxelTimeAtlas)
+{
+	uint32 Hash = 0;
+	for (FIVSmokeVolumeGPUData GPUData : RenderData.VolumeDataArray)
+	{
+		// Step quality follows the view, the grids don't read it
+		GPUData.StepQuality = 0.0f;
+		GPUData.Reserved = 0.0f;
+		Hash = FCrc::MemCrc32(&GPUData, sizeof(GPUData), Hash);
+	}
+
+	// Light direction is compared against a threshold instead, see AddMultiVolumeRayMarchPass
+	Hash = FCrc::MemCrc32(&RenderData.LightTransmittanceDensityKey, sizeof(RenderData.LightTransmittanceDensityKey), Hash);
+
+	const float Params[] = {
+		RenderData.GlobalAbsorption,
+		RenderData.SmokeSize,
+		RenderData.VolumeRangeOffset,
+		RenderData.VolumeEdgeNoiseFadeOffset,
+		RenderData.VolumeEdgeFadeSharpness,
+		bVoxelTimeAtlas ? 1.0f : 0.0f
+	};
+	return FCrc::MemCrc32(Params, sizeof(Params), Hash);
+}
+
+void FIVSmokeRenderer::AddTemporalAccumulatePass(
+	FRDGBuilder& GraphBuilder,
+	const FSceneView& View,
+	const FIVSmokePackedRenderData& RenderData,
+	FRDGTextureRef& InOutSmokeAlbedo,
+	FRDGTextureRef& InOutSmokeLocalPosAlpha,
+	FRDGTextureRef SmokeWorldPosDepth,
+	const FIntPoint& TexSize)
+{
+	const uint32 FrameNumber = View.Family->FrameNumber;
+
+	// Drop histories of views that stopped rendering (closed viewports, destroyed view states)
+	for (auto It = TemporalHistories.CreateIterator(); It; ++It)
+	{
+		if (It.Key() != View.State && FrameNumber - It.Value()->LastFrameNumber > 60)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TUniquePtr<FTemporalHistory>& HistoryPtr = TemporalHistories.FindOrAdd(View.State);
+	if (!HistoryPtr)
+	{
+		HistoryPtr = MakeUnique<FTemporalHistory>();
+	}
+	FTemporalHistory& History = *HistoryPtr;
+
+	// History is sampled by reprojected UV, so it stays valid across dynamic resolution steps
+	const bool bHistoryValid = History.Albedo.IsValid() && History.LocalPosAlpha.IsValid()
+		&& FrameNumber - History.LastFrameNumber <= 2
+		&& !View.bCameraCut;
+
+	FRDGTextureDesc AccumulatedDesc = FRDGTextureDesc::Create2D(
+		TexSize, PF_FloatRGBA, FClearValueBinding::Black,
+		TexCreate_ShaderResource | TexCreate_UAV
+	);
+	FRDGTextureRef AccumulatedAlbedo = GraphBuilder.CreateTexture(AccumulatedDesc, TEXT("IVSmoke_TemporalAlbedo"));
+	FRDGTextureRef AccumulatedLocalPosAlpha = GraphBuilder.CreateTexture(AccumulatedDesc, TEXT("IVSmoke_TemporalLocalPosAlpha"));
+
+	FGlobalShaderMap* ShaderMap = GetGlobalShaderMap(View.FeatureLevel);
+	TShaderMapRef<FIVSmokeTemporalAccumulateCS> ComputeShader(ShaderMap);
+	auto* Parameters = GraphBuilder.AllocParameters<FIVSmokeTemporalAccumulateCS::FParameters>();
+	Parameters->OutAlbedo = GraphBuilder.CreateUAV(AccumulatedAlbedo);
+	Parameters->OutLocalPosAlpha = GraphBuilder.CreateUAV(AccumulatedLocalPosAlpha);
+	Parameters->CurrentAlbedo = InOutSmokeAlbedo;
+	Parameters->CurrentLocalPosAlpha = InOutSmokeLocalPosAlpha;
+	Parameters->CurrentWorldPosDepth = SmokeWorldPosDepth;
+	Parameters->HistoryAlbedo = bHistoryValid ? GraphBuilder.RegisterExternalTexture(History.Albedo) : InOutSmokeAlbedo;
+	Parameters->HistoryLocalPosAlpha = bHistoryValid ? GraphBuilder.RegisterExternalTexture(History.LocalPosAlpha) : InOutSmokeLocalPosAlpha;
+	Parameters->LinearClamp_Sampler = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+	Parameters->PrevTranslatedWorldToClip = FMatrix44f(History.PrevTranslatedWorldToClip);
+	Parameters->PrevViewOrigin = FVector3f(History.PrevViewOrigin);
+	Parameters->TexSize = TexSize;
+	Parameters->HistoryWeight = bHistoryValid ? FMath::Clamp(RenderData.TemporalHistoryWeight, 0.0f, 0.98f) : 0.0f;
+	Parameters->ChangedHistoryScale = ChangedVolumeHistoryScale;
+
+	// Few volumes change per frame, test them individually, otherwise scale history everywhere
+	const int32 NumChangedVolumes = RenderData.ChangedVolumeBounds.Num();
+	if (NumChangedVolumes > FIVSmokeTemporalAccumulateCS::MaxChangedVolumes)
+	{
+		Parameters->NumChangedVolumes = -1;
+	}
+	else
+	{
+		Parameters->NumChangedVolumes = NumChangedVolumes;
+		for (int32 i = 0; i < NumChangedVolumes; ++i)
+		{
+			Parameters->ChangedVolumeMin[i] = FVector4f(RenderData.ChangedVolumeBounds[i].Min, 0.0f);
+			Parameters->ChangedVolumeMax[i] = FVector4f(RenderData.ChangedVolumeBounds[i].Max, 0.0f);
+		}
+	}
+
+	FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeTemporalAccumulateCS>(
+		GraphBuilder,
+		ShaderMap,
+		ComputeShader,
+		Parameters,
+		FIntVector(TexSize.X, TexSize.Y, 1)
+	);
+
+	// Keep this frame's result and camera for the next frame's reprojection (matrices without TAA jitter,
+	// the ray march builds its rays from the unjittered camera)
+	GraphBuilder.QueueTextureExtraction(AccumulatedAlbedo, &History.Albedo);
+	GraphBuilder.QueueTextureExtraction(AccumulatedLocalPosAlpha, &History.LocalPosAlpha);
+	History.PrevViewOrigin = View.ViewMatrices.GetViewOrigin();
+	History.PrevTranslatedWorldToClip = FTranslationMatrix(History.PrevViewOrigin) * View.ViewMatrices.GetViewMatrix() * View.ViewMatrices.GetProjectionNoAAMatrix();
+	History.LastFrameNumber = FrameNumber;
+
+	InOutSmokeAlbedo = AccumulatedAlbedo;
+	InOutSmokeLocalPosAlpha = AccumulatedLocalPosAlpha;
+}
+
 //~==============================================================================
 // Stats Tracking
 
@@ -1493,10 +1999,13 @@ void FIVSmokeRenderer::UpdateStatsIfNeeded(const FIVSmokePackedRenderData& Rende
 	CachedPerFrameSize = CalculatePerFrameTextureSize(
 		ViewportSize,
 		RenderData.VolumeCount,
-		RenderData.VoxelResolution,
-		RenderData.HoleResolution
+		RenderData.VoxelResolution
 	);
 
+	// Persistent hole and voxel atlases
+	CachedHoleAtlasSize = FIVSmokeHoleAtlas::Get().GetMemorySize_RenderThread();
+	CachedVoxelAtlasSize = FIVSmokeVoxelAtlas::Get().GetMemorySize_RenderThread();
+
 	// Calculate CSM size using CalcTextureMemorySizeEnum
 	CachedCSMSize = 0;
 	if (CSMRenderer && CSMRenderer->IsInitialized())
@@ -1522,8 +2031,7 @@ void FIVSmokeRenderer::UpdateStatsIfNeeded(const FIVSmokePackedRenderData& Rende
 int64 FIVSmokeRenderer::CalculatePerFrameTextureSize(
 	const FIntPoint& ViewportSize,
 	int32 VolumeCount,
-	const FIntVector& VoxelResolution,
-	const FIntVector& HoleResolution
+	const FIntVector& VoxelResolution
 ) const
 {
 	if (VolumeCount == 0)
@@ -1533,31 +2041,21 @@ int64 FIVSmokeRenderer::CalculatePerFrameTextureSize(
 
 	int64 TotalSize = 0;
 
-	// Half-resolution Smoke Albedo + Mask (PF_FloatRGBA)
-	const FIntPoint HalfSize(FMath::Max(1, ViewportSize.X / 2), FMath::Max(1, ViewportSize.Y / 2));
-	TotalSize += CalculateImageBytes(HalfSize.X, HalfSize.Y, 1, PF_FloatRGBA) * 2;
+	// Ray march resolution Smoke Albedo + Mask (PF_FloatRGBA)
+	const FIntPoint RayMarchSize = ComputeRayMarchSize(ViewportSize, RayMarchResolutionScale);
+	TotalSize += CalculateImageBytes(RayMarchSize.X, RayMarchSize.Y, 1, PF_FloatRGBA) * 2;
 
-	// Voxel Atlas: Use existing GetAtlasTexCount logic constants
-	const int32 TexturePackInterval = 4;
-	const int32 TexturePackMaxSize = 2048;
+	// PackedVoxelAtlasFXAA (PF_R32_FLOAT), the density and time atlases themselves are persistent (FIVSmokeVoxelAtlas)
+	const FIVSmokeVoxelAtlasLayout& VoxelAtlasLayout = FIVSmokeVoxelAtlas::Get().GetLayout_RenderThread();
+	if (VoxelAtlasLayout.IsValid() && !VoxelAtlasLayout.bTimeAtlas)
+	{
+		const FIntVector VoxelAtlasResolution = VoxelAtlasLayout.GetAtlasResolution();
+		TotalSize += CalculateImageBytes(VoxelAtlasResolution.X, VoxelAtlasResolution.Y, VoxelAtlasResolution.Z, PF_R32_FLOAT);
 
-	FIntVector VoxelAtlasCount = GetAtlasTexCount(VoxelResolution, VolumeCount, TexturePackInterval, TexturePackMaxSize);
-	FIntVector VoxelAtlasResolution(
-		VoxelResolution.X * VoxelAtlasCount.X + TexturePackInterval * (VoxelAtlasCount.X - 1),
-		VoxelResolution.Y * VoxelAtlasCount.Y + TexturePackInterval * (VoxelAtlasCount.Y - 1),
-		VoxelResolution.Z * VoxelAtlasCount.Z + TexturePackInterval * (VoxelAtlasCount.Z - 1)
-	);
-	// PackedVoxelAtlas (PF_R32_FLOAT) + PackedVoxelAtlasFXAA (PF_R32_FLOAT)
-	TotalSize += CalculateImageBytes(VoxelAtlasResolution.X, VoxelAtlasResolution.Y, VoxelAtlasResolution.Z, PF_R32_FLOAT) * 2;
-
-	// Hole Atlas (PF_FloatRGBA)
-	FIntVector HoleAtlasCount = GetAtlasTexCount(HoleResolution, VolumeCount, TexturePackInterval, TexturePackMaxSize);
-	FIntVector HoleAtlasResolution(
-		HoleResolution.X * HoleAtlasCount.X + TexturePackInterval * (HoleAtlasCount.X - 1),
-		HoleResolution.Y * HoleAtlasCount.Y + TexturePackInterval * (HoleAtlasCount.Y - 1),
-		HoleResolution.Z * HoleAtlasCount.Z + TexturePackInterval * (HoleAtlasCount.Z - 1)
-	);
-	TotalSize += CalculateImageBytes(HoleAtlasResolution.X, HoleAtlasResolution.Y, HoleAtlasResolution.Z, PF_FloatRGBA);
+		// VoxelMacroCellAtlas (PF_R32_FLOAT)
+		const FIntVector MacroCellResolution = VoxelAtlasLayout.GetMacroCellResolution();
+		TotalSize += CalculateImageBytes(MacroCellResolution.X, MacroCellResolution.Y, MacroCellResolution.Z, PF_R32_FLOAT);
+	}
 
 	// Occupancy textures (View + Light): Use FIVSmokeOccupancyConfig constants
 	const UIVSmokeSettings* Settings = UIVSmokeSettings::Get();
@@ -1570,6 +2068,13 @@ int64 FIVSmokeRenderer::CalculatePerFrameTextureSize(
 		const uint32 StepSliceCount = (Settings->GetEffectiveMaxSteps() + FIVSmokeOccupancyConfig::StepDivisor - 1) / FIVSmokeOccupancyConfig::StepDivisor;
 		// uint4 = 16 bytes per texel, 2 textures (View + Light)
 		TotalSize += CalculateImageBytes(TileCount.X, TileCount.Y, StepSliceCount, PF_R32G32B32A32_UINT) * 2;
+
+		// LightTransmittanceAtlas (PF_R16F)
+		if (Settings->IsSelfShadowingEnabled() && Settings->bUseLightTransmittanceVolume)
+		{
+			const FIntVector LightTransmittanceResolution = FIVSmokeLightTransmittanceConfig::GetAtlasResolution(VolumeCount);
+			TotalSize += CalculateImageBytes(LightTransmittanceResolution.X, LightTransmittanceResolution.Y, LightTransmittanceResolution.Z, PF_R16F);
+		}
 	}
 
 	return TotalSize;
@@ -1581,7 +2086,168 @@ void FIVSmokeRenderer::UpdateAllStats()
 	SET_MEMORY_STAT(STAT_IVSmoke_NoiseVolume, CachedNoiseVolumeSize);
 	SET_MEMORY_STAT(STAT_IVSmoke_CSMShadowMaps, CachedCSMSize);
 	SET_MEMORY_STAT(STAT_IVSmoke_PerFrameTextures, CachedPerFrameSize);
-	SET_MEMORY_STAT(STAT_IVSmoke_TotalVRAM, CachedNoiseVolumeSize + CachedCSMSize + CachedPerFrameSize);
+	SET_MEMORY_STAT(STAT_IVSmoke_HoleAtlas, CachedHoleAtlasSize);
+	SET_MEMORY_STAT(STAT_IVSmoke_VoxelAtlas, CachedVoxelAtlasSize);
+	SET_MEMORY_STAT(STAT_IVSmoke_TotalVRAM, CachedNoiseVolumeSize + CachedCSMSize + CachedPerFrameSize + CachedHoleAtlasSize + CachedVoxelAtlasSize);
+
+	// Dynamic resolution stats
+	SET_FLOAT_STAT(STAT_IVSmoke_RayMarchResolutionScale, RayMarchResolutionScale);
+	SET_FLOAT_STAT(STAT_IVSmoke_PrePassGPUTime, LastPrePassGPUTimeMs);
+}
+
+//~==============================================================================
+// Dynamic Resolution
+
+FIntPoint FIVSmokeRenderer::ComputeRayMarchSize(const FIntPoint& ViewportSize, float Scale)
+{
+	return FIntPoint(
+		FMath::Max(1, FMath::FloorToInt(ViewportSize.X * Scale)),
+		FMath::Max(1, FMath::FloorToInt(ViewportSize.Y * Scale))
+	);
+}
+
+float FIVSmokeRenderer::UpdateRayMarchResolutionScale(const UIVSmokeSettings& Settings, const FSceneView& View)
+{
+	if (!Settings.bEnableDynamicResolution)
+	{
+		DynamicResolutionStates.Empty();
+		RayMarchResolutionScale = 0.5f;
+		return RayMarchResolutionScale;
+	}
+
+	const uint32 FrameNumber = View.Family->FrameNumber;
+
+	// Drop states of views that stopped rendering (closed viewports, destroyed view states)
+	for (auto It = DynamicResolutionStates.CreateIterator(); It; ++It)
+	{
+		if (It.Key() != View.State && FrameNumber - It.Value().LastFrameNumber > 60)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FDynamicResolutionState& State = DynamicResolutionStates.FindOrAdd(View.State);
+	State.LastFrameNumber = FrameNumber;
+
+	// Consume finished timings in submission order, never wait on the GPU
+	int32 NumConsumed = 0;
+	for (const FPrePassTiming& Timing : State.PendingTimings)
+	{
+		// A pre-pass that returned before the ray march misses timestamps, it is dropped without a sample
+		bool bComplete = true;
+		for (const FRHIPooledRenderQuery& Timestamp : Timing.Timestamps)
+		{
+			bComplete &= Timestamp.GetQuery() != nullptr;
+		}
+
+		uint64 Microseconds[(int32)EPrePassTimestamp::Num] = {};
+		bool bReady = true;
+		for (int32 Index = 0; Index < (int32)EPrePassTimestamp::Num && bComplete && bReady; ++Index)
+		{
+			bReady = RHIGetRenderQueryResult(Timing.Timestamps[Index].GetQuery(), Microseconds[Index], false);
+		}
+		if (!bReady)
+		{
+			break;
+		}
+		++NumConsumed;
+		if (!bComplete)
+		{
+			continue;
+		}
+
+		const uint64 Begin = Microseconds[(int32)EPrePassTimestamp::Begin];
+		const uint64 ScaledBegin = Microseconds[(int32)EPrePassTimestamp::ScaledBegin];
+		const uint64 ScaledEnd = Microseconds[(int32)EPrePassTimestamp::ScaledEnd];
+		const uint64 End = Microseconds[(int32)EPrePassTimestamp::End];
+		if (!(Begin <= ScaledBegin && ScaledBegin < ScaledEnd && ScaledEnd <= End))
+		{
+			continue;
+		}
+
+		// Only the scaled passes grow with the ray march area, normalize them to full resolution and keep the rest as is
+		const double GPUTimeMs = (End - Begin) / 1000.0;
+		const double ScaledMs = (ScaledEnd - ScaledBegin) / 1000.0;
+		const double CostMs = ScaledMs / FMath::Square((double)Timing.Scale);
+		const double FixedMs = GPUTimeMs - ScaledMs;
+		const bool bFirstSample = State.SmoothedCostMs <= 0.0;
+		State.SmoothedCostMs = bFirstSample ? CostMs : FMath::Lerp(State.SmoothedCostMs, CostMs, 0.2);
+		State.SmoothedFixedMs = bFirstSample ? FixedMs : FMath::Lerp(State.SmoothedFixedMs, FixedMs, 0.2);
+		LastPrePassGPUTimeMs = (float)GPUTimeMs;
+	}
+	State.PendingTimings.RemoveAt(0, NumConsumed);
+
+	// Drop timings that never resolve (e.g. rendering paused) instead of queueing forever.
+	// The queue is per view, so a few frames of readback latency fit regardless of the view count.
+	constexpr int32 MaxPendingTimings = 8;
+	if (State.PendingTimings.Num() > MaxPendingTimings)
+	{
+		State.PendingTimings.RemoveAt(0, State.PendingTimings.Num() - MaxPendingTimings);
+	}
+
+	const float MinScale = FMath::Clamp(Settings.MinDynamicResolutionScale, 0.25f, 1.0f);
+	const float MaxScale = FMath::Clamp(Settings.MaxDynamicResolutionScale, MinScale, 1.0f);
+
+	if (State.SmoothedCostMs > 0.0)
+	{
+		// Budget = Fixed + Cost * Scale^2, whatever the fixed passes leave goes to the ray march
+		const double ScaledBudgetMs = FMath::Max(Settings.DynamicResolutionBudgetMs - State.SmoothedFixedMs, 0.0);
+		const float TargetScale = FMath::Clamp(
+			(float)FMath::Sqrt(ScaledBudgetMs / State.SmoothedCostMs), MinScale, MaxScale);
+
+		// Hysteresis of one step, snapped down so the new scale stays within budget
+		if (FMath::Abs(TargetScale - State.Scale) >= RayMarchResolutionScaleStep)
+		{
+			State.Scale = FMath::FloorToFloat(TargetScale / RayMarchResolutionScaleStep) * RayMarchResolutionScaleStep;
+		}
+	}
+	State.Scale = FMath::Clamp(State.Scale, MinScale, MaxScale);
+
+	RayMarchResolutionScale = State.Scale;
+	return State.Scale;
+}
+
+void FIVSmokeRenderer::BeginPrePassTiming(FRDGBuilder& GraphBuilder, const FSceneView& View, float Scale)
+{
+	if (!TimestampQueryPool.IsValid())
+	{
+		TimestampQueryPool = RHICreateRenderQueryPool(RQT_AbsoluteTime);
+	}
+
+	FPrePassTiming& Timing = DynamicResolutionStates.FindOrAdd(View.State).PendingTimings.AddDefaulted_GetRef();
+	Timing.Scale = Scale;
+
+	bTimingPrePass = true;
+	AddPrePassTimestamp(GraphBuilder, View, EPrePassTimestamp::Begin);
+}
+
+void FIVSmokeRenderer::EndPrePassTiming(FRDGBuilder& GraphBuilder, const FSceneView& View)
+{
+	AddPrePassTimestamp(GraphBuilder, View, EPrePassTimestamp::End);
+	bTimingPrePass = false;
+}
+
+void FIVSmokeRenderer::AddPrePassTimestamp(FRDGBuilder& GraphBuilder, const FSceneView& View, EPrePassTimestamp Timestamp)
+{
+	if (!bTimingPrePass)
+	{
+		return;
+	}
+
+	FDynamicResolutionState* State = DynamicResolutionStates.Find(View.State);
+	check(State && State->PendingTimings.Num() > 0);
+
+	FRHIPooledRenderQuery& PooledQuery = State->PendingTimings.Last().Timestamps[(int32)Timestamp];
+	PooledQuery = TimestampQueryPool->AllocateQuery();
+
+	FRHIRenderQuery* Query = PooledQuery.GetQuery();
+	GraphBuilder.AddPass(
+		RDG_EVENT_NAME("IVSmoke_PrePassTimestamp"),
+		ERDGPassFlags::None | ERDGPassFlags::NeverCull,
+		[Query](FRHICommandListImmediate& RHICmdList)
+		{
+			RHICmdList.EndRenderQuery(Query);
+		});
 }
 
 //~==============================================================================
@@ -1626,17 +2292,14 @@ void FIVSmokeRenderer::RunPrePassPipeline(
 	}
 
 	// Get cached render data (prepared on Game Thread via BeginRenderViewFamily)
-	FIVSmokePackedRenderData RenderData;
-	{
-		FScopeLock Lock(&RenderDataMutex);
-		RenderData = CachedRenderData;
-	}
+	const FIVSmokeRenderDataSnapshot RenderDataSnapshot = GetCachedRenderData();
 
 	// Early out if no valid render data
-	if (!RenderData.bIsValid || RenderData.VolumeCount == 0)
+	if (!RenderDataSnapshot.IsValid() || !RenderDataSnapshot->bIsValid || RenderDataSnapshot->VolumeCount == 0)
 	{
 		return;
 	}
+	const FIVSmokePackedRenderData& RenderData = *RenderDataSnapshot;
 
 	// Ensure renderer is initialized
 	if (!NoiseVolume)
@@ -1661,11 +2324,15 @@ void FIVSmokeRenderer::RunPrePassPipeline(
 	FViewRDGCache& Cache = FrameViewCaches.FindOrAdd(View.State);
 
 	//~==========================================================================
-	// Resolution Setup
-	const FIntPoint HalfSize = FIntPoint(
-		FMath::Max(1, ViewportSize.X / 2),
-		FMath::Max(1, ViewportSize.Y / 2)
-	);
+	// Resolution Setup (half resolution, or scaled to the GPU time budget)
+	const float ResolutionScale = UpdateRayMarchResolutionScale(*Settings, View);
+	const FIntPoint RayMarchSize = ComputeRayMarchSize(ViewportSize, ResolutionScale);
+	const FVector2f UpsampleRatio = FVector2f(ViewportSize) / FVector2f(RayMarchSize);
+
+	if (Settings->bEnableDynamicResolution)
+	{
+		BeginPrePassTiming(GraphBuilder, View, ResolutionScale);
+	}
 
 	//~==========================================================================
 	// Create textures at full resolution for cache
@@ -1679,34 +2346,46 @@ void FIVSmokeRenderer::RunPrePassPipeline(
 	Cache.WorldPosDepthTex = GraphBuilder.CreateTexture(FullResDesc, TEXT("IVSmoke_WorldPosDepthTex"));
 
 	//~==========================================================================
-	// Create temporary textures at 1/2 resolution
-	FRDGTextureDesc HalfResDesc = FRDGTextureDesc::Create2D(
-		HalfSize, PF_FloatRGBA, FClearValueBinding::Black,
+	// Create temporary textures at ray march resolution
+	FRDGTextureDesc RayMarchResDesc = FRDGTextureDesc::Create2D(
+		RayMarchSize, PF_FloatRGBA, FClearValueBinding::Black,
 		TexCreate_RenderTargetable | TexCreate_ShaderResource | TexCreate_UAV
 	);
 
-	FRDGTextureRef SmokeAlbedoHalf = GraphBuilder.CreateTexture(HalfResDesc, TEXT("IVSmokeAlbedoTex_Half_PrePass"));
-	FRDGTextureRef SmokeLocalPosAlphaHalf = GraphBuilder.CreateTexture(HalfResDesc, TEXT("IVSmokeLocalPosAlphaTex_Half_PrePass"));
-	FRDGTextureRef SmokeWorldPosDepthHalf = GraphBuilder.CreateTexture(HalfResDesc, TEXT("IVSmokeWorldPosDepthTex_Half_PrePass"));
+	FRDGTextureRef SmokeAlbedoRayMarch = GraphBuilder.CreateTexture(RayMarchResDesc, TEXT("IVSmokeAlbedoTex_RayMarch_PrePass"));
+	FRDGTextureRef SmokeLocalPosAlphaRayMarch = GraphBuilder.CreateTexture(RayMarchResDesc, TEXT("IVSmokeLocalPosAlphaTex_RayMarch_PrePass"));
+	FRDGTextureRef SmokeWorldPosDepthRayMarch = GraphBuilder.CreateTexture(RayMarchResDesc, TEXT("IVSmokeWorldPosDepthTex_RayMarch_PrePass"));
 
 	//~==========================================================================
-	// Ray March Pass (1/2 Resolution)
+	// Ray March Pass (Reduced Resolution)
 	// Pass SceneDepth explicitly to create RDG dependency
 	FRDGTextureRef SceneDepthTexture = RenderTargets.DepthStencil.GetTexture();
 	AddMultiVolumeRayMarchPass(
 		GraphBuilder, View, RenderData,
-		SmokeAlbedoHalf, SmokeLocalPosAlphaHalf, SmokeWorldPosDepthHalf,
-		HalfSize, ViewportSize, ViewRectMin,
+		SmokeAlbedoRayMarch, SmokeLocalPosAlphaRayMarch, SmokeWorldPosDepthRayMarch,
+		RayMarchSize, ViewportSize, ViewRectMin,
 		SceneDepthTexture  // Explicit RDG dependency
 	);
 
 	//~==========================================================================
-	// Upscaling (1/2 to Full) - Copy to cache textures
+	// Temporal Accumulation (Reduced Resolution, optional)
+	if (RenderData.bEnableTemporalAccumulation)
+	{
+		AddTemporalAccumulatePass(
+			GraphBuilder, View, RenderData,
+			SmokeAlbedoRayMarch, SmokeLocalPosAlphaRayMarch, SmokeWorldPosDepthRayMarch,
+			RayMarchSize
+		);
+	}
+	AddPrePassTimestamp(GraphBuilder, View, EPrePassTimestamp::ScaledEnd);
+
+	//~==========================================================================
+	// Upscaling (Reduced to Full) - Copy to cache textures
 	FRDGTextureRef SmokeAlbedoFull = AddCopyPass(
-		GraphBuilder, View, SmokeAlbedoHalf, ViewportSize, TEXT("IVSmokeAlbedoTex_Full_PrePass")
+		GraphBuilder, View, SmokeAlbedoRayMarch, ViewportSize, TEXT("IVSmokeAlbedoTex_Full_PrePass")
 	);
-	AddCopyPass(GraphBuilder, View, SmokeLocalPosAlphaHalf, Cache.LocalPosAlphaTex);
-	AddCopyPass(GraphBuilder, View, SmokeWorldPosDepthHalf, Cache.WorldPosDepthTex);
+	AddCopyPass(GraphBuilder, View, SmokeLocalPosAlphaRayMarch, Cache.LocalPosAlphaTex);
+	AddCopyPass(GraphBuilder, View, SmokeWorldPosDepthRayMarch, Cache.WorldPosDepthTex);
 
 	//~==========================================================================
 	// Upsample Filter Pass
@@ -1714,7 +2393,7 @@ void FIVSmokeRenderer::RunPrePassPipeline(
 		GraphBuilder, RenderData, View,
 		SmokeAlbedoFull,  // Dummy for SceneTex (not used in output)
 		SmokeAlbedoFull, Cache.LocalPosAlphaTex,
-		ViewportSize, ViewRectMin
+		ViewportSize, ViewRectMin, UpsampleRatio
 	);
 
 	// Copy filtered result to cached SmokeTex
@@ -1731,6 +2410,11 @@ void FIVSmokeRenderer::RunPrePassPipeline(
 		);
 	}
 
+	if (Settings->bEnableDynamicResolution)
+	{
+		EndPrePassTiming(GraphBuilder, View);
+	}
+
 	//~==========================================================================
 	// Mark Cache as Valid
 	Cache.ViewportSize = ViewportSize;
@@ -16,6 +16,34 @@
 
 TSharedPtr<FIVSmokeSceneViewExtension, ESPMode::ThreadSafe> FIVSmokeSceneViewExtension::Instance;
 
+namespace
+{
+	/**
+	 * Whether the volume's active smoke, grown by Margin, intersects the frustum of any view in the family.
+	 * Volumes without active voxels have nothing to draw and are culled.
+	 */
+	bool IsVolumeInAnyView(const AIVSmokeVoxelVolume* Volume, const FSceneViewFamily& ViewFamily, const float Margin)
+	{
+		const FVector BoundsMin = Volume->GetVoxelWorldAABBMin();
+		const FVector BoundsMax = Volume->GetVoxelWorldAABBMax();
+		if (BoundsMin.X > BoundsMax.X || BoundsMin.Y > BoundsMax.Y || BoundsMin.Z > BoundsMax.Z)
+		{
+			return false;
+		}
+
+		const FVector Origin = (BoundsMin + BoundsMax) * 0.5;
+		const FVector Extent = (BoundsMax - BoundsMin) * 0.5 + FVector(Margin);
+		for (const FSceneView* View : ViewFamily.Views)
+		{
+			if (View && View->ViewFrustum.IntersectBox(Origin, Extent))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
 FIVSmokeSceneViewExtension::FIVSmokeSceneViewExtension(const FAutoRegister& AutoRegister)
 	: FSceneViewExtensionBase(AutoRegister)
 {
@@ -52,6 +80,14 @@ void FIVSmokeSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewF
 		return;
 	}
 
+	// Families rendered by scene captures, including the renderer's own CSM captures from inside PrepareRenderData,
+	// keep the snapshot of the main view. Preparing for them would re-cull the volumes and overwrite that snapshot.
+	const bool bIsSceneCapture = InViewFamily.Views.Num() > 0 && InViewFamily.Views[0] && InViewFamily.Views[0]->bIsSceneCapture;
+	if (Renderer.IsCapturingShadow() || bIsSceneCapture)
+	{
+		return;
+	}
+
 	// Sync server time if needed
 	if (!Renderer.bIsServerTimeSynced())
 	{
@@ -64,10 +100,14 @@ void FIVSmokeSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewF
 	}
 
 	// Collect renderable volumes using TActorIterator (Pull-based pattern)
+	// Volumes outside every view are dropped here, before any packing, upload or tile setup
+	const UIVSmokeSettings* Settings = UIVSmokeSettings::Get();
+	const bool bFrustumCulling = Settings && Settings->bEnableFrustumCulling && InViewFamily.Views.Num() > 0;
+	const float FrustumCullingMargin = Settings ? Settings->FrustumCullingMargin : 0.0f;
 	TArray<AIVSmokeVoxelVolume*> ValidVolumes;
 	for (TActorIterator<AIVSmokeVoxelVolume> It(World); It; ++It)
 	{
-		if (It->ShouldRender())
+		if (It->ShouldRender() && (!bFrustumCulling || IsVolumeInAnyView(*It, InViewFamily, FrustumCullingMargin)))
 		{
 			ValidVolumes.Add(*It);
 		}
@@ -79,23 +119,26 @@ void FIVSmokeSceneViewExtension::BeginRenderViewFamily(FSceneViewFamily& InViewF
 		ENQUEUE_RENDER_COMMAND(IVSmokeClearRenderData)(
 			[&Renderer](FRHICommandListImmediate& RHICmdList)
 			{
-				Renderer.SetCachedRenderData(FIVSmokePackedRenderData());
+				Renderer.SetCachedRenderData(nullptr);
 			}
 		);
 		return;
 	}
 
-	// Get camera position from first view for distance-based filtering
+	// Get camera position and projection from first view for significance ranking
 	FVector CameraPosition = FVector::ZeroVector;
+	FMatrix ProjectionMatrix = FMatrix::Identity;
 	if (InViewFamily.Views.Num() > 0 && InViewFamily.Views[0])
 	{
 		CameraPosition = InViewFamily.Views[0]->ViewLocation;
+		ProjectionMatrix = InViewFamily.Views[0]->ViewMatrices.GetProjectionMatrix();
 	}
 
 	// Prepare render data on Game Thread (all Volume data access happens here)
-	FIVSmokePackedRenderData RenderData = Renderer.PrepareRenderData(ValidVolumes, CameraPosition);
-	
-	// Transfer to Render Thread via command queue
+	FIVSmokeRenderDataSnapshot RenderData = MakeShared<FIVSmokePackedRenderData, ESPMode::ThreadSafe>(
+		Renderer.PrepareRenderData(ValidVolumes, CameraPosition, ProjectionMatrix));
+
+	// Transfer to Render Thread via command queue, views share the snapshot without copying it
 	ENQUEUE_RENDER_COMMAND(IVSmokeSetRenderData)(
 		[&Renderer, RenderData = MoveTemp(RenderData)](FRHICommandListImmediate& RHICmdList) mutable
 		{
@@ -6,6 +6,8 @@
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeNoiseGeneratorGlobalCS, "/Plugin/IVSmoke/IVSmokeNoiseGeneratorCS.usf", "GenerateNoise", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeStructuredToTextureCS, "/Plugin/IVSmoke/IVSmokeStructuredToTextureCS.usf", "MainCS", SF_Compute);
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeVoxelFXAACS, "/Plugin/IVSmoke/IVSmokeVoxelFXAACS.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FIVSmokeMacroCellBuildCS, "/Plugin/IVSmoke/IVSmokeMacroCellBuildCS.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FIVSmokeTemporalAccumulateCS, "/Plugin/IVSmoke/IVSmokeTemporalAccumulateCS.usf", "MainCS", SF_Compute);
 
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeCompositePS, "/Plugin/IVSmoke/IVSmokeCompositePS.usf", "MainPS", SF_Pixel);
 IMPLEMENT_GLOBAL_SHADER(FIVSmokeCopyPS, "/Plugin/IVSmoke/IVSmokeCopy.usf", "MainPS", SF_Pixel);
@@ -0,0 +1,680 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#include "IVSmokeVoxelAtlas.h"
+
+#include "IVSmoke.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderingThread.h"
+#include "ShaderParameterMacros.h"
+
+//~============================================================================
+// Layout
+#pragma region Layout
+FIntVector FIVSmokeVoxelAtlasLayout::GetAtlasResolution() const
+{
+	return BrickCount * FIVSmokeVoxelAtlas::BrickSize;
+}
+
+FIntVector FIVSmokeVoxelAtlasLayout::GetMacroCellResolution() const
+{
+	static_assert(FIVSmokeVoxelAtlas::BrickSize % FIVSmokeVoxelAtlas::MacroCellSize == 0, "Macro cells must tile a brick");
+	static_assert(FIVSmokeVoxelAtlas::SlotInterval % FIVSmokeVoxelAtlas::MacroCellSize == 0, "Macro cells must line up with slot grids");
+	return GetAtlasResolution() / FIVSmokeVoxelAtlas::MacroCellSize;
+}
+#pragma endregion
+
+#if !UE_SERVER
+/** Region updates of the time atlas run as copy passes. */
+BEGIN_SHADER_PARAMETER_STRUCT(FIVSmokeVoxelTimeUploadParameters, )
+	RDG_TEXTURE_ACCESS(TimeAtlas, ERHIAccess::CopyDest)
+	RDG_TEXTURE_ACCESS(MacroCellAtlas, ERHIAccess::CopyDest)
+END_SHADER_PARAMETER_STRUCT()
+
+namespace
+{
+	/** Macro cell of the time atlas without any voxel: never born, already dead. */
+	const FVector2f EmptyMacroCellTimes(UE_BIG_NUMBER, 0.0f);
+
+	int32 GetBrickIndex(const FIntVector& BrickCount, const int32 X, const int32 Y, const int32 Z)
+	{
+		return X + BrickCount.X * (Y + BrickCount.Y * Z);
+	}
+
+	/** First-fit search for a free box of Extent bricks, scanning Z, Y, then X and skipping past blocking bricks. */
+	bool FindFreeBricks(const TBitArray<>& Occupancy, const FIntVector& BrickCount, const FIntVector& Extent, FIntVector& OutMin)
+	{
+		if (Extent.X > BrickCount.X || Extent.Y > BrickCount.Y || Extent.Z > BrickCount.Z)
+		{
+			return false;
+		}
+
+		for (int32 Z = 0; Z <= BrickCount.Z - Extent.Z; ++Z)
+		{
+			for (int32 Y = 0; Y <= BrickCount.Y - Extent.Y; ++Y)
+			{
+				int32 X = 0;
+				while (X <= BrickCount.X - Extent.X)
+				{
+					int32 BlockingX = INDEX_NONE;
+					for (int32 DZ = 0; DZ < Extent.Z; ++DZ)
+					{
+						for (int32 DY = 0; DY < Extent.Y; ++DY)
+						{
+							for (int32 DX = Extent.X - 1; X + DX > BlockingX; --DX)
+							{
+								if (Occupancy[GetBrickIndex(BrickCount, X + DX, Y + DY, Z + DZ)])
+								{
+									BlockingX = X + DX;
+									break;
+								}
+							}
+						}
+					}
+
+					if (BlockingX == INDEX_NONE)
+					{
+						OutMin = FIntVector(X, Y, Z);
+						return true;
+					}
+					X = BlockingX + 1;
+				}
+			}
+		}
+		return false;
+	}
+
+	void SetBricksOccupied(TBitArray<>& Occupancy, const FIntVector& BrickCount, const FIntVector& Min, const FIntVector& Extent, const bool bOccupied)
+	{
+		for (int32 Z = Min.Z; Z < Min.Z + Extent.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y < Min.Y + Extent.Y; ++Y)
+			{
+				for (int32 X = Min.X; X < Min.X + Extent.X; ++X)
+				{
+					Occupancy[GetBrickIndex(BrickCount, X, Y, Z)] = bOccupied;
+				}
+			}
+		}
+	}
+}
+
+FIVSmokeVoxelAtlas& FIVSmokeVoxelAtlas::Get()
+{
+	static FIVSmokeVoxelAtlas Instance;
+	return Instance;
+}
+
+//~============================================================================
+// Game Thread
+#pragma region Game Thread
+int32 FIVSmokeVoxelAtlas::AllocateSlot(const FIntVector& Resolution)
+{
+	check(IsInGameThread());
+
+	// Padding is reserved on every side, so stale bricks of freed slots never bleed into live ones
+	constexpr int32 MaxBrickCount = MaxAtlasSize / BrickSize;
+	const FIntVector BrickExtent(
+		FMath::DivideAndRoundUp(Resolution.X + SlotInterval * 2, BrickSize),
+		FMath::DivideAndRoundUp(Resolution.Y + SlotInterval * 2, BrickSize),
+		FMath::DivideAndRoundUp(Resolution.Z + SlotInterval * 2, BrickSize));
+	if (Resolution.GetMin() <= 0 || BrickExtent.GetMax() > MaxBrickCount)
+	{
+		UE_LOG(LogIVSmoke, Verbose, TEXT("[FIVSmokeVoxelAtlas::AllocateSlot] Unsupported voxel resolution %s."), *Resolution.ToString());
+		return INDEX_NONE;
+	}
+
+	FIVSmokeVoxelAtlasLayout NewLayout = Layout;
+	if (NewLayout.BrickCount.GetMin() <= 0)
+	{
+		NewLayout.BrickCount = FIntVector(
+			FMath::Max(MinBrickCount, BrickExtent.X),
+			FMath::Max(MinBrickCount, BrickExtent.Y),
+			FMath::Max(MinBrickCount, BrickExtent.Z));
+		BrickOccupancy.Init(false, NewLayout.BrickCount.X * NewLayout.BrickCount.Y * NewLayout.BrickCount.Z);
+	}
+
+	const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop() : Regions.AddDefaulted();
+	FIVSmokeVoxelAtlasRegion NewRegion;
+	NewRegion.Resolution = Resolution;
+	NewRegion.BrickExtent = BrickExtent;
+	NewRegion.BufferOffset = AllocateBufferRange(NewRegion.GetVoxelCount(), NewLayout.BufferCapacity);
+	Regions[Slot] = NewRegion;
+
+	FIntVector BrickMin;
+	if (FindFreeBricks(BrickOccupancy, NewLayout.BrickCount, BrickExtent, BrickMin))
+	{
+		Regions[Slot].BrickMin = BrickMin;
+		Regions[Slot].AtlasOffset = BrickMin * BrickSize + FIntVector(SlotInterval);
+		SetBricksOccupied(BrickOccupancy, NewLayout.BrickCount, BrickMin, BrickExtent, true);
+	}
+	else
+	{
+		// Double the smallest axis until every slot fits again
+		bool bRepacked = false;
+		while (!bRepacked)
+		{
+			int32 GrowAxis = INDEX_NONE;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (NewLayout.BrickCount[Axis] < MaxBrickCount && (GrowAxis == INDEX_NONE || NewLayout.BrickCount[Axis] < NewLayout.BrickCount[GrowAxis]))
+				{
+					GrowAxis = Axis;
+				}
+			}
+			if (GrowAxis == INDEX_NONE)
+			{
+				break;
+			}
+			NewLayout.BrickCount[GrowAxis] = FMath::Min(NewLayout.BrickCount[GrowAxis] * 2, MaxBrickCount);
+			bRepacked = RepackBricks(NewLayout.BrickCount);
+		}
+
+		if (!bRepacked)
+		{
+			UE_LOG(LogIVSmoke, Verbose, TEXT("[FIVSmokeVoxelAtlas::AllocateSlot] Voxel atlas is full (%s bricks), cannot fit %s."),
+				*Layout.BrickCount.ToString(), *Resolution.ToString());
+			FreeBufferRange(NewRegion.BufferOffset, NewRegion.GetVoxelCount());
+			Regions[Slot] = FIVSmokeVoxelAtlasRegion();
+			FreeSlots.Add(Slot);
+			return INDEX_NONE;
+		}
+	}
+
+	UploadedSlots.SetNum(Regions.Num(), false);
+	UploadedSlots[Slot] = false;
+
+	Relayout(NewLayout);
+	return Slot;
+}
+
+void FIVSmokeVoxelAtlas::FreeSlot(const int32 Slot)
+{
+	check(IsInGameThread());
+
+	if (!Regions.IsValidIndex(Slot) || !Regions[Slot].IsValid())
+	{
+		return;
+	}
+
+	const FIVSmokeVoxelAtlasRegion& Region = Regions[Slot];
+	SetBricksOccupied(BrickOccupancy, Layout.BrickCount, Region.BrickMin, Region.BrickExtent, false);
+	FreeBufferRange(Region.BufferOffset, Region.GetVoxelCount());
+
+	Regions[Slot] = FIVSmokeVoxelAtlasRegion();
+	UploadedSlots[Slot] = false;
+	FreeSlots.Add(Slot);
+
+	// A queued upload would land on the range of whichever slot reuses the freed one after a re-pack
+	ENQUEUE_RENDER_COMMAND(IVSmokeVoxelAtlasFreeSlot)(
+		[this, Slot](FRHICommandListImmediate& RHICmdList)
+		{
+			PendingUploads.RemoveAllSwap([Slot](const FPendingUpload& Pending) { return Pending.Slot == Slot; });
+		}
+	);
+}
+
+void FIVSmokeVoxelAtlas::UploadSlot(const int32 Slot, TArray<float> BirthTimes, TArray<float> DeathTimes)
+{
+	check(IsInGameThread());
+
+	if (!Regions.IsValidIndex(Slot) || !Regions[Slot].IsValid())
+	{
+		return;
+	}
+	UploadedSlots[Slot] = true;
+
+	// Slots are allocated for their volume's resolution, the renderer re-allocates when it changes
+	const FIVSmokeVoxelAtlasRegion& Region = Regions[Slot];
+	const int32 NumVoxels = FMath::Min3(BirthTimes.Num(), DeathTimes.Num(), Region.GetVoxelCount());
+	BirthTimes.SetNum(NumVoxels);
+	DeathTimes.SetNum(NumVoxels);
+
+	FPendingUpload Upload;
+	Upload.Slot = Slot;
+	Upload.Region = Region;
+	Upload.BirthTimes = MoveTemp(BirthTimes);
+	Upload.DeathTimes = MoveTemp(DeathTimes);
+
+	ENQUEUE_RENDER_COMMAND(IVSmokeVoxelAtlasUploadSlot)(
+		[this, Upload = MoveTemp(Upload)](FRHICommandListImmediate& RHICmdList) mutable
+		{
+			// Only the latest data of a slot is uploaded
+			PendingUploads.RemoveAllSwap([&Upload](const FPendingUpload& Pending) { return Pending.Slot == Upload.Slot; });
+			PendingUploads.Add(MoveTemp(Upload));
+		}
+	);
+}
+
+bool FIVSmokeVoxelAtlas::RepackBricks(const FIntVector& BrickCount)
+{
+	TArray<int32> Order;
+	for (int32 Slot = 0; Slot < Regions.Num(); ++Slot)
+	{
+		if (Regions[Slot].IsValid())
+		{
+			Order.Add(Slot);
+		}
+	}
+	Order.Sort([this](const int32 A, const int32 B)
+	{
+		const FIntVector& ExtentA = Regions[A].BrickExtent;
+		const FIntVector& ExtentB = Regions[B].BrickExtent;
+		return ExtentA.X * ExtentA.Y * ExtentA.Z > ExtentB.X * ExtentB.Y * ExtentB.Z;
+	});
+
+	TBitArray<> NewOccupancy(false, BrickCount.X * BrickCount.Y * BrickCount.Z);
+	TArray<FIntVector> NewBrickMins;
+	NewBrickMins.SetNum(Regions.Num());
+	for (const int32 Slot : Order)
+	{
+		if (!FindFreeBricks(NewOccupancy, BrickCount, Regions[Slot].BrickExtent, NewBrickMins[Slot]))
+		{
+			return false;
+		}
+		SetBricksOccupied(NewOccupancy, BrickCount, NewBrickMins[Slot], Regions[Slot].BrickExtent, true);
+	}
+
+	BrickOccupancy = MoveTemp(NewOccupancy);
+	for (const int32 Slot : Order)
+	{
+		Regions[Slot].BrickMin = NewBrickMins[Slot];
+		Regions[Slot].AtlasOffset = NewBrickMins[Slot] * BrickSize + FIntVector(SlotInterval);
+	}
+	return true;
+}
+
+int32 FIVSmokeVoxelAtlas::AllocateBufferRange(const int32 Count, int32& InOutBufferCapacity)
+{
+	for (int32 Index = 0; Index < FreeBufferRanges.Num(); ++Index)
+	{
+		FBufferRange& Range = FreeBufferRanges[Index];
+		if (Range.Count >= Count)
+		{
+			const int32 Offset = Range.Offset;
+			Range.Offset += Count;
+			Range.Count -= Count;
+			if (Range.Count == 0)
+			{
+				FreeBufferRanges.RemoveAt(Index);
+			}
+			return Offset;
+		}
+	}
+
+	const int32 Offset = BufferEnd;
+	BufferEnd += Count;
+	if (BufferEnd > InOutBufferCapacity)
+	{
+		InOutBufferCapacity = FMath::Max<int32>(MinBufferCapacity, FMath::RoundUpToPowerOfTwo(BufferEnd));
+	}
+	return Offset;
+}
+
+void FIVSmokeVoxelAtlas::FreeBufferRange(const int32 Offset, const int32 Count)
+{
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// Keep free ranges sorted by offset and merged
+	int32 Index = 0;
+	while (Index < FreeBufferRanges.Num() && FreeBufferRanges[Index].Offset < Offset)
+	{
+		++Index;
+	}
+	FreeBufferRanges.Insert(FBufferRange{ Offset, Count }, Index);
+	if (FreeBufferRanges.IsValidIndex(Index + 1) && Offset + Count == FreeBufferRanges[Index + 1].Offset)
+	{
+		FreeBufferRanges[Index].Count += FreeBufferRanges[Index + 1].Count;
+		FreeBufferRanges.RemoveAt(Index + 1);
+	}
+	if (Index > 0 && FreeBufferRanges[Index - 1].Offset + FreeBufferRanges[Index - 1].Count == Offset)
+	{
+		FreeBufferRanges[Index - 1].Count += FreeBufferRanges[Index].Count;
+		FreeBufferRanges.RemoveAt(Index);
+	}
+
+	// A free tail shrinks the used part of the buffers instead
+	if (FreeBufferRanges.Num() > 0 && FreeBufferRanges.Last().Offset + FreeBufferRanges.Last().Count == BufferEnd)
+	{
+		BufferEnd = FreeBufferRanges.Pop().Offset;
+	}
+}
+
+void FIVSmokeVoxelAtlas::SetTimeAtlas(const bool bTimeAtlas)
+{
+	check(IsInGameThread());
+
+	FIVSmokeVoxelAtlasLayout NewLayout = Layout;
+	NewLayout.bTimeAtlas = bTimeAtlas;
+	Relayout(NewLayout);
+}
+
+void FIVSmokeVoxelAtlas::Relayout(const FIVSmokeVoxelAtlasLayout& NewLayout)
+{
+	if (NewLayout == Layout)
+	{
+		return;
+	}
+
+	// The time atlas is only written by uploads, switching paths or moving its regions loses slot contents
+	const bool bModeChanged = NewLayout.bTimeAtlas != Layout.bTimeAtlas;
+	const bool bAtlasChanged = NewLayout.BrickCount != Layout.BrickCount;
+	if (bModeChanged || (bAtlasChanged && NewLayout.bTimeAtlas))
+	{
+		UploadedSlots.Init(false, Regions.Num());
+	}
+	Layout = NewLayout;
+
+	// Resources are re-created on next use. Buffers carry their contents over, the density atlas is re-evaluated every frame.
+	ENQUEUE_RENDER_COMMAND(IVSmokeVoxelAtlasRelayout)(
+		[this, NewLayout, bModeChanged, bAtlasChanged](FRHICommandListImmediate& RHICmdList)
+		{
+			if (bModeChanged || (bAtlasChanged && NewLayout.bTimeAtlas))
+			{
+				// Queued uploads target the other path or old region positions, every slot is uploaded again
+				PendingUploads.Reset();
+			}
+			if (bModeChanged || bAtlasChanged)
+			{
+				DensityAtlas.SafeRelease();
+				TimeAtlas.SafeRelease();
+				TimeMacroCellAtlas.SafeRelease();
+			}
+			if (bModeChanged)
+			{
+				BirthTimesBuffer.SafeRelease();
+				DeathTimesBuffer.SafeRelease();
+			}
+			RenderLayout = NewLayout;
+		}
+	);
+}
+
+void FIVSmokeVoxelAtlas::Release()
+{
+	UploadedSlots.Init(false, Regions.Num());
+
+	ENQUEUE_RENDER_COMMAND(IVSmokeVoxelAtlasRelease)(
+		[this](FRHICommandListImmediate& RHICmdList)
+		{
+			PendingUploads.Reset();
+			BirthTimesBuffer.SafeRelease();
+			DeathTimesBuffer.SafeRelease();
+			DensityAtlas.SafeRelease();
+			TimeAtlas.SafeRelease();
+			TimeMacroCellAtlas.SafeRelease();
+		}
+	);
+}
+#pragma endregion
+
+//~============================================================================
+// Render Thread
+#pragma region Render Thread
+bool FIVSmokeVoxelAtlas::RegisterBuffers(FRDGBuilder& GraphBuilder, FRDGBufferRef& OutBirthTimes, FRDGBufferRef& OutDeathTimes)
+{
+	check(IsInRenderingThread());
+
+	if (!RenderLayout.IsValid() || RenderLayout.bTimeAtlas)
+	{
+		return false;
+	}
+
+	const uint64 BufferBytes = static_cast<uint64>(RenderLayout.BufferCapacity) * sizeof(float);
+	if (BirthTimesBuffer.IsValid() && DeathTimesBuffer.IsValid() && BirthTimesBuffer->GetSize() == BufferBytes)
+	{
+		OutBirthTimes = GraphBuilder.RegisterExternalBuffer(BirthTimesBuffer);
+		OutDeathTimes = GraphBuilder.RegisterExternalBuffer(DeathTimesBuffer);
+	}
+	else
+	{
+		// Zero birth time is "no voxel", so ranges read empty until uploaded
+		const FRDGBufferDesc BufferDesc = FRDGBufferDesc::CreateStructuredDesc(sizeof(float), RenderLayout.BufferCapacity);
+		OutBirthTimes = GraphBuilder.CreateBuffer(BufferDesc, TEXT("IVSmoke_VoxelAtlasBirthTimes"));
+		OutDeathTimes = GraphBuilder.CreateBuffer(BufferDesc, TEXT("IVSmoke_VoxelAtlasDeathTimes"));
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(OutBirthTimes), 0u);
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(OutDeathTimes), 0u);
+
+		// Buffer ranges never move, so grown buffers keep every uploaded slot
+		if (BirthTimesBuffer.IsValid() && DeathTimesBuffer.IsValid())
+		{
+			const uint64 CopyBytes = FMath::Min<uint64>(BirthTimesBuffer->GetSize(), BufferBytes);
+			AddCopyBufferPass(GraphBuilder, OutBirthTimes, 0, GraphBuilder.RegisterExternalBuffer(BirthTimesBuffer), 0, CopyBytes);
+			AddCopyBufferPass(GraphBuilder, OutDeathTimes, 0, GraphBuilder.RegisterExternalBuffer(DeathTimesBuffer), 0, CopyBytes);
+		}
+
+		BirthTimesBuffer = GraphBuilder.ConvertToExternalBuffer(OutBirthTimes);
+		DeathTimesBuffer = GraphBuilder.ConvertToExternalBuffer(OutDeathTimes);
+	}
+
+	// Copy only the slots whose voxel data changed
+	for (FPendingUpload& Upload : PendingUploads)
+	{
+		const int32 NumVoxels = Upload.BirthTimes.Num();
+		if (NumVoxels == 0 || Upload.Region.BufferOffset + NumVoxels > RenderLayout.BufferCapacity)
+		{
+			continue;
+		}
+
+		const FRDGBufferDesc UploadDesc = FRDGBufferDesc::CreateStructuredDesc(sizeof(float), NumVoxels);
+		const FRDGBufferRef BirthUpload = GraphBuilder.CreateBuffer(UploadDesc, TEXT("IVSmoke_VoxelSlotBirthTimes"));
+		const FRDGBufferRef DeathUpload = GraphBuilder.CreateBuffer(UploadDesc, TEXT("IVSmoke_VoxelSlotDeathTimes"));
+		GraphBuilder.QueueBufferUpload(BirthUpload, Upload.BirthTimes.GetData(), NumVoxels * sizeof(float));
+		GraphBuilder.QueueBufferUpload(DeathUpload, Upload.DeathTimes.GetData(), NumVoxels * sizeof(float));
+
+		const uint64 ByteOffset = static_cast<uint64>(Upload.Region.BufferOffset) * sizeof(float);
+		AddCopyBufferPass(GraphBuilder, OutBirthTimes, ByteOffset, BirthUpload, 0, NumVoxels * sizeof(float));
+		AddCopyBufferPass(GraphBuilder, OutDeathTimes, ByteOffset, DeathUpload, 0, NumVoxels * sizeof(float));
+	}
+	PendingUploads.Reset();
+
+	return true;
+}
+
+FRDGTextureRef FIVSmokeVoxelAtlas::RegisterDensityAtlas(FRDGBuilder& GraphBuilder)
+{
+	check(IsInRenderingThread());
+
+	if (!RenderLayout.IsValid())
+	{
+		return nullptr;
+	}
+
+	if (DensityAtlas.IsValid())
+	{
+		return GraphBuilder.RegisterExternalTexture(DensityAtlas);
+	}
+
+	const FRDGTextureDesc AtlasDesc = FRDGTextureDesc::Create3D(
+		RenderLayout.GetAtlasResolution(),
+		PF_R32_FLOAT,
+		FClearValueBinding::None,
+		TexCreate_ShaderResource | TexCreate_UAV
+	);
+	const FRDGTextureRef Texture = GraphBuilder.CreateTexture(AtlasDesc, TEXT("IVSmoke_PackedVoxelAtlas"));
+
+	// Unused bricks are never written and must read empty
+	AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Texture), 0.0f);
+
+	DensityAtlas = GraphBuilder.ConvertToExternalTexture(Texture);
+	return Texture;
+}
+
+FRDGTextureRef FIVSmokeVoxelAtlas::RegisterTimeAtlas(FRDGBuilder& GraphBuilder, FRDGTextureRef& OutMacroCellAtlas)
+{
+	check(IsInRenderingThread());
+
+	OutMacroCellAtlas = nullptr;
+	if (!RenderLayout.IsValid() || !RenderLayout.bTimeAtlas)
+	{
+		return nullptr;
+	}
+
+	FRDGTextureRef Texture = nullptr;
+	FRDGTextureRef MacroCellTexture = nullptr;
+	if (TimeAtlas.IsValid() && TimeMacroCellAtlas.IsValid())
+	{
+		Texture = GraphBuilder.RegisterExternalTexture(TimeAtlas);
+		MacroCellTexture = GraphBuilder.RegisterExternalTexture(TimeMacroCellAtlas);
+	}
+	else
+	{
+		const FRDGTextureDesc AtlasDesc = FRDGTextureDesc::Create3D(
+			RenderLayout.GetAtlasResolution(),
+			PF_G32R32F,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		Texture = GraphBuilder.CreateTexture(AtlasDesc, TEXT("IVSmoke_VoxelTimeAtlas"));
+
+		const FRDGTextureDesc MacroCellDesc = FRDGTextureDesc::Create3D(
+			RenderLayout.GetMacroCellResolution(),
+			PF_G32R32F,
+			FClearValueBinding::None,
+			TexCreate_ShaderResource | TexCreate_UAV
+		);
+		MacroCellTexture = GraphBuilder.CreateTexture(MacroCellDesc, TEXT("IVSmoke_VoxelTimeMacroCellAtlas"));
+
+		// Zero birth time is "no voxel", unused bricks and their macro cells read empty
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(Texture), FVector4f::Zero());
+		AddClearUAVPass(GraphBuilder, GraphBuilder.CreateUAV(MacroCellTexture), FVector4f(EmptyMacroCellTimes.X, EmptyMacroCellTimes.Y, 0.0f, 0.0f));
+		TimeAtlas = GraphBuilder.ConvertToExternalTexture(Texture);
+		TimeMacroCellAtlas = GraphBuilder.ConvertToExternalTexture(MacroCellTexture);
+	}
+
+	// Write the slot's whole brick box, zeroed padding included, so stale bricks of freed slots are overwritten
+	for (FPendingUpload& Upload : PendingUploads)
+	{
+		const FIVSmokeVoxelAtlasRegion& Region = Upload.Region;
+		const int32 NumVoxels = Upload.BirthTimes.Num();
+		if (NumVoxels == 0 || !Region.IsValid())
+		{
+			continue;
+		}
+
+		const FIntVector BoxMin = Region.BrickMin * BrickSize;
+		const FIntVector BoxSize = Region.BrickExtent * BrickSize;
+		const FIntVector GridMin = Region.AtlasOffset - BoxMin;
+		const FIntVector CellBoxMin = BoxMin / MacroCellSize;
+		const FIntVector CellBoxSize = BoxSize / MacroCellSize;
+		TArray<FVector2f> BoxTimes;
+		BoxTimes.SetNumZeroed(BoxSize.X * BoxSize.Y * BoxSize.Z);
+		TArray<FVector2f> CellTimes;
+		CellTimes.Init(EmptyMacroCellTimes, CellBoxSize.X * CellBoxSize.Y * CellBoxSize.Z);
+		for (int32 Index = 0; Index < NumVoxels; ++Index)
+		{
+			const int32 X = Index % Region.Resolution.X;
+			const int32 Y = (Index / Region.Resolution.X) % Region.Resolution.Y;
+			const int32 Z = Index / (Region.Resolution.X * Region.Resolution.Y);
+			const FIntVector BoxPos(GridMin.X + X, GridMin.Y + Y, GridMin.Z + Z);
+			const int32 BoxIndex = BoxPos.X + BoxSize.X * (BoxPos.Y + BoxSize.Y * BoxPos.Z);
+			const float BirthTime = Upload.BirthTimes[Index];
+			const float DeathTime = Upload.DeathTimes[Index];
+			BoxTimes[BoxIndex] = FVector2f(BirthTime, DeathTime);
+
+			// Same validity as IsValidVoxelTime, a voxel without death time never fades out
+			if (BirthTime < 0.001f)
+			{
+				continue;
+			}
+			const FIntVector CellPos = BoxPos / MacroCellSize;
+			FVector2f& Cell = CellTimes[CellPos.X + CellBoxSize.X * (CellPos.Y + CellBoxSize.Y * CellPos.Z)];
+			Cell.X = FMath::Min(Cell.X, BirthTime);
+			Cell.Y = FMath::Max(Cell.Y, DeathTime >= 0.001f ? DeathTime : UE_BIG_NUMBER);
+		}
+
+		// Trilinear samples inside a cell read one voxel into the neighbor cells, widen every cell by its neighbors.
+		// The outermost cells are slot padding and stay empty, so the box edge needs no neighbors of other slots.
+		TArray<FVector2f> DilatedCellTimes;
+		DilatedCellTimes.Init(EmptyMacroCellTimes, CellTimes.Num());
+		for (int32 Z = 0; Z < CellBoxSize.Z; ++Z)
+		{
+			for (int32 Y = 0; Y < CellBoxSize.Y; ++Y)
+			{
+				for (int32 X = 0; X < CellBoxSize.X; ++X)
+				{
+					FVector2f& Dilated = DilatedCellTimes[X + CellBoxSize.X * (Y + CellBoxSize.Y * Z)];
+					for (int32 NZ = FMath::Max(Z - 1, 0); NZ <= FMath::Min(Z + 1, CellBoxSize.Z - 1); ++NZ)
+					{
+						for (int32 NY = FMath::Max(Y - 1, 0); NY <= FMath::Min(Y + 1, CellBoxSize.Y - 1); ++NY)
+						{
+							for (int32 NX = FMath::Max(X - 1, 0); NX <= FMath::Min(X + 1, CellBoxSize.X - 1); ++NX)
+							{
+								const FVector2f& Neighbor = CellTimes[NX + CellBoxSize.X * (NY + CellBoxSize.Y * NZ)];
+								Dilated.X = FMath::Min(Dilated.X, Neighbor.X);
+								Dilated.Y = FMath::Max(Dilated.Y, Neighbor.Y);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		FIVSmokeVoxelTimeUploadParameters* PassParameters = GraphBuilder.AllocParameters<FIVSmokeVoxelTimeUploadParameters>();
+		PassParameters->TimeAtlas = Texture;
+		PassParameters->MacroCellAtlas = MacroCellTexture;
+		GraphBuilder.AddPass(
+			RDG_EVENT_NAME("IVSmokeVoxelTimeUpload"),
+			PassParameters,
+			ERDGPassFlags::Copy | ERDGPassFlags::NeverCull,
+			[PassParameters, BoxMin, BoxSize, CellBoxMin, CellBoxSize, BoxTimes = MoveTemp(BoxTimes), DilatedCellTimes = MoveTemp(DilatedCellTimes)](FRHICommandListImmediate& RHICmdList)
+			{
+				const FUpdateTextureRegion3D UpdateRegion(BoxMin.X, BoxMin.Y, BoxMin.Z, 0, 0, 0, BoxSize.X, BoxSize.Y, BoxSize.Z);
+				RHICmdList.UpdateTexture3D(
+					PassParameters->TimeAtlas->GetRHI(),
+					0,
+					UpdateRegion,
+					BoxSize.X * sizeof(FVector2f),
+					BoxSize.X * BoxSize.Y * sizeof(FVector2f),
+					reinterpret_cast<const uint8*>(BoxTimes.GetData()));
+
+				const FUpdateTextureRegion3D CellRegion(CellBoxMin.X, CellBoxMin.Y, CellBoxMin.Z, 0, 0, 0, CellBoxSize.X, CellBoxSize.Y, CellBoxSize.Z);
+				RHICmdList.UpdateTexture3D(
+					PassParameters->MacroCellAtlas->GetRHI(),
+					0,
+					CellRegion,
+					CellBoxSize.X * sizeof(FVector2f),
+					CellBoxSize.X * CellBoxSize.Y * sizeof(FVector2f),
+					reinterpret_cast<const uint8*>(DilatedCellTimes.GetData()));
+			}
+		);
+	}
+	PendingUploads.Reset();
+
+	OutMacroCellAtlas = MacroCellTexture;
+	return Texture;
+}
+
+int64 FIVSmokeVoxelAtlas::GetMemorySize_RenderThread() const
+{
+	int64 TotalSize = 0;
+	if (BirthTimesBuffer.IsValid())
+	{
+		TotalSize += BirthTimesBuffer->GetSize();
+	}
+	if (DeathTimesBuffer.IsValid())
+	{
+		TotalSize += DeathTimesBuffer->GetSize();
+	}
+	if (DensityAtlas.IsValid())
+	{
+		const FIntVector AtlasResolution = RenderLayout.GetAtlasResolution();
+		TotalSize += CalculateImageBytes(AtlasResolution.X, AtlasResolution.Y, AtlasResolution.Z, PF_R32_FLOAT);
+	}
+	if (TimeAtlas.IsValid())
+	{
+		const FIntVector AtlasResolution = RenderLayout.GetAtlasResolution();
+		TotalSize += CalculateImageBytes(AtlasResolution.X, AtlasResolution.Y, AtlasResolution.Z, PF_G32R32F);
+	}
+	if (TimeMacroCellAtlas.IsValid())
+	{
+		const FIntVector MacroCellResolution = RenderLayout.GetMacroCellResolution();
+		TotalSize += CalculateImageBytes(MacroCellResolution.X, MacroCellResolution.Y, MacroCellResolution.Z, PF_G32R32F);
+	}
+	return TotalSize;
+}
+#pragma endregion
+#endif
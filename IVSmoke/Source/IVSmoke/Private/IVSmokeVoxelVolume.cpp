@@ -1059,6 +1059,31 @@ bool AIVSmokeVoxelVolume::ShouldRender() const
 		|| State == EIVSmokeVoxelVolumeState::Dissipation;
 }
 
+bool AIVSmokeVoxelVolume::TraceActiveVoxelSpan(const FVector& Origin, const FVector& Direction, double& OutEntryDistance, double& OutExitDistance) const
+{
+	const FVector NormalizedDirection = Direction.GetSafeNormal();
+	if (ActiveVoxelNum <= 0 || NormalizedDirection.IsNearlyZero())
+	{
+		return false;
+	}
+
+	// 1. Closed-form slab test against the current voxel AABB
+	double TStart, TEnd;
+	if (!UIVSmokeGridLibrary::RayBoxIntersection(GetVoxelWorldAABBMin(), GetVoxelWorldAABBMax(), Origin, NormalizedDirection, TStart, TEnd))
+	{
+		return false;
+	}
+
+	// 2. Move to grid space, where voxel G covers [G, G + 1). The transform is affine, so T stays in world units.
+	const FTransform& ActorTransform = GetActorTransform();
+	const FVector GridOrigin = ActorTransform.InverseTransformPosition(Origin) / VoxelSize + FVector(GetCenterOffset()) + 0.5;
+	const FVector GridDirection = ActorTransform.InverseTransformVector(NormalizedDirection) / VoxelSize;
+
+	// 3. DDA over VoxelBits, padded by one voxel like the voxel AABB (trilinear density reaches past the active cells)
+	return UIVSmokeGridLibrary::TraceVoxelBitSpan(VoxelBits, GetGridResolution(), GridOrigin, GridDirection,
+		TStart, TEnd, VoxelSize, OutEntryDistance, OutExitDistance);
+}
+
 TObjectPtr<UIVSmokeHoleGeneratorComponent> AIVSmokeVoxelVolume::GetHoleGeneratorComponent()
 {
 	if (!IsValid(HoleGeneratorComponent))
@@ -1079,15 +1104,6 @@ TObjectPtr<UIVSmokeCollisionComponent> AIVSmokeVoxelVolume::GetCollisionComponen
 	return CollisionComponent;
 }
 
-FTextureRHIRef AIVSmokeVoxelVolume::GetHoleTexture() const
-{
-	if (HoleGeneratorComponent)
-	{
-		return HoleGeneratorComponent->GetHoleTextureRHI();
-	}
-	return nullptr;
-}
-
 float AIVSmokeVoxelVolume::GetSyncWorldTimeSeconds() const
 {
 	UWorld* World = GetWorld();
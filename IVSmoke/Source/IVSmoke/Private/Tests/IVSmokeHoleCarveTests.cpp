@@ -0,0 +1,325 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GlobalShader.h"
+#include "IVSmokeGridLibrary.h"
+#include "IVSmokeHolePreset.h"
+#include "IVSmokeHoleShaders.h"
+#include "IVSmokePostProcessPass.h"
+#include "Misc/App.h"
+#include "RHIStaticStates.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderUtils.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+
+//~============================================================================
+// Hole carve golden tests
+//
+// Every hole type is checked three ways:
+// 1. Known mask values of FIVSmokeHoleCarveCPU at points inside and outside the hole.
+// 2. The brick binned Carve against an unbinned Evaluate of every hole, so binning never drops a hole.
+// 3. The GPU carve pass (IVSmokeHoleCarveCS.usf) against the CPU Carve, when a RHI is available.
+// Edge noise strength is zero on the GPU, the CPU carve does not evaluate it.
+
+namespace IVSmokeHoleCarveTests
+{
+	const FVector3f VolumeMin(0.0f, 0.0f, 0.0f);
+	const FVector3f VolumeMax(400.0f, 400.0f, 400.0f);
+	const FIntVector Resolution(32, 32, 32);
+
+	/** Mask tolerance of the GPU comparison, the carve texture is PF_FloatRGBA. */
+	constexpr float GPUMaskTolerance = 2e-3f;
+
+	FIVSmokeHoleGPU MakeHole(const EIVSmokeHoleType HoleType)
+	{
+		FIVSmokeHoleGPU Hole;
+		FMemory::Memzero(Hole);
+		Hole.HoleType = static_cast<int32>(HoleType);
+		Hole.ExpansionCurveIndex = INDEX_NONE;
+		Hole.ShrinkCurveIndex = INDEX_NONE;
+		return Hole;
+	}
+
+	bool TestMask(FAutomationTestBase& Test, const TCHAR* What, const FIVSmokeHoleCarveCPU& Carve, const FVector3f& WorldPos, const float Time, const float Expected, const float Tolerance)
+	{
+		return Test.TestEqual(What, Carve.Evaluate(WorldPos, Time).W, Expected, Tolerance);
+	}
+
+	/** Binned Carve must produce the unbinned result at every voxel center. */
+	bool TestCarveMatchesEvaluate(FAutomationTestBase& Test, const FIVSmokeHoleCarveCPU& Carve, const float Time, TArray<FVector4f>& OutVolume)
+	{
+		Carve.Carve(Resolution, Time, OutVolume);
+
+		const FVector3f VoxelSize = (VolumeMax - VolumeMin) / FVector3f(Resolution);
+		int32 NumMismatches = 0;
+		for (int32 Z = 0; Z < Resolution.Z; ++Z)
+		{
+			for (int32 Y = 0; Y < Resolution.Y; ++Y)
+			{
+				for (int32 X = 0; X < Resolution.X; ++X)
+				{
+					const FVector3f WorldPos = VolumeMin + (FVector3f(X, Y, Z) + 0.5f) * VoxelSize;
+					const FVector4f Expected = Carve.Evaluate(WorldPos, Time);
+					const FVector4f& Carved = OutVolume[X + (Y + Z * Resolution.Y) * Resolution.X];
+					if (!Carved.Equals(Expected, 1e-4f) && NumMismatches++ == 0)
+					{
+						Test.AddError(FString::Printf(TEXT("Binned carve differs at voxel (%d, %d, %d): %s, expected %s"),
+							X, Y, Z, *Carved.ToString(), *Expected.ToString()));
+					}
+				}
+			}
+		}
+		return Test.TestEqual(TEXT("Binned carve mismatches"), NumMismatches, 0);
+	}
+
+	/** Run the carve pass on Holes and read the volume back. @return false without a RHI. */
+	bool CarveOnGPU(const TArray<FIVSmokeHoleGPU>& Holes, const float Time, TArray<FVector4f>& OutVolume)
+	{
+		if (!FApp::CanEverRender() || GUsingNullRHI)
+		{
+			return false;
+		}
+
+		FIVSmokeHoleBrickBins BrickBins;
+		BrickBins.Build(Holes, TArray<float>(), VolumeMin, VolumeMax, Resolution);
+		if (BrickBins.ActiveBricks.Num() == 0)
+		{
+			OutVolume.Init(FVector4f(0.0f, 0.0f, 0.0f, 1.0f), Resolution.X * Resolution.Y * Resolution.Z);
+			return true;
+		}
+
+		TArray<FFloat16Color> Readback;
+		ENQUEUE_RENDER_COMMAND(IVSmokeHoleCarveTest)(
+			[&Holes, &BrickBins, &Readback, Time](FRHICommandListImmediate& RHICmdList)
+			{
+				FRDGBuilder GraphBuilder(RHICmdList);
+
+				// The shader reads a curve LUT buffer even when no hole references it
+				const TArray<float> CurveLUT = { 0.0f };
+
+				const FRDGTextureDesc CarveTexDesc = FRDGTextureDesc::Create3D(
+					Resolution,
+					PF_FloatRGBA,
+					FClearValueBinding::Black,
+					TexCreate_ShaderResource | TexCreate_UAV
+				);
+				const FRDGTextureRef RDGTexture = GraphBuilder.CreateTexture(CarveTexDesc, TEXT("IVSmokeHoleCarveTest"));
+				const FRDGTextureUAVRef VolumeUAV = GraphBuilder.CreateUAV(RDGTexture);
+				AddClearUAVPass(GraphBuilder, VolumeUAV, FVector4f(0.0f, 0.0f, 0.0f, 1.0f));
+
+				const FRDGBufferRef HoleBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("IVSmokeHoleCarveTestHoles"),
+					sizeof(FIVSmokeHoleGPU), Holes.Num(), Holes.GetData(), sizeof(FIVSmokeHoleGPU) * Holes.Num());
+				const FRDGBufferRef CurveLUTBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("IVSmokeHoleCarveTestCurveLUT"),
+					sizeof(float), CurveLUT.Num(), CurveLUT.GetData(), sizeof(float) * CurveLUT.Num());
+				const FRDGBufferRef BrickRangeBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("IVSmokeHoleCarveTestBrickRanges"),
+					sizeof(FUintVector2), BrickBins.BrickRanges.Num(), BrickBins.BrickRanges.GetData(), sizeof(FUintVector2) * BrickBins.BrickRanges.Num());
+				const FRDGBufferRef BrickHoleIndexBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("IVSmokeHoleCarveTestBrickIndices"),
+					sizeof(uint32), BrickBins.BrickHoleIndices.Num(), BrickBins.BrickHoleIndices.GetData(), sizeof(uint32) * BrickBins.BrickHoleIndices.Num());
+				const FRDGBufferRef ActiveBrickBuffer = CreateStructuredBuffer(GraphBuilder, TEXT("IVSmokeHoleCarveTestActiveBricks"),
+					sizeof(uint32), BrickBins.ActiveBricks.Num(), BrickBins.ActiveBricks.GetData(), sizeof(uint32) * BrickBins.ActiveBricks.Num());
+
+				FIVSmokeHoleCarveCS::FParameters* CarveParameters = GraphBuilder.AllocParameters<FIVSmokeHoleCarveCS::FParameters>();
+				CarveParameters->VolumeTexture = VolumeUAV;
+				CarveParameters->HoleBuffer = GraphBuilder.CreateSRV(HoleBuffer);
+				CarveParameters->CurveLUTBuffer = GraphBuilder.CreateSRV(CurveLUTBuffer);
+				CarveParameters->BrickHoleRanges = GraphBuilder.CreateSRV(BrickRangeBuffer);
+				CarveParameters->BrickHoleIndices = GraphBuilder.CreateSRV(BrickHoleIndexBuffer);
+				CarveParameters->ActiveBricks = GraphBuilder.CreateSRV(ActiveBrickBuffer);
+				CarveParameters->BrickCount = BrickBins.BrickCount;
+				CarveParameters->VolumeMin = VolumeMin;
+				CarveParameters->VolumeMax = VolumeMax;
+				CarveParameters->Resolution = Resolution;
+				CarveParameters->CurrentServerTime = Time;
+				CarveParameters->PenetrationNoiseTexture = GWhiteTexture->TextureRHI;
+				CarveParameters->ExplosionNoiseTexture = GWhiteTexture->TextureRHI;
+				CarveParameters->DynamicNoiseTexture = GWhiteTexture->TextureRHI;
+				CarveParameters->NoiseSampler = TStaticSamplerState<SF_Bilinear, AM_Wrap, AM_Wrap, AM_Wrap>::GetRHI();
+				CarveParameters->PenetrationNoiseStrength = 0.0f;
+				CarveParameters->PenetrationNoiseScale = 1.0f;
+				CarveParameters->ExplosionNoiseStrength = 0.0f;
+				CarveParameters->ExplosionNoiseScale = 1.0f;
+				CarveParameters->DynamicNoiseStrength = 0.0f;
+				CarveParameters->DynamicNoiseScale = 1.0f;
+
+				const FIntVector CarveThreads(
+					BrickBins.ActiveBricks.Num() * FIVSmokeHoleCarveCS::ThreadGroupSizeX,
+					FIVSmokeHoleCarveCS::ThreadGroupSizeY,
+					FIVSmokeHoleCarveCS::ThreadGroupSizeZ);
+				const TShaderMapRef<FIVSmokeHoleCarveCS> CarveShader(GetGlobalShaderMap(GMaxRHIFeatureLevel));
+				FIVSmokePostProcessPass::AddComputeShaderPass<FIVSmokeHoleCarveCS>(GraphBuilder, GetGlobalShaderMap(GMaxRHIFeatureLevel), CarveShader, CarveParameters, CarveThreads);
+
+				TRefCountPtr<IPooledRenderTarget> CarvedVolume;
+				GraphBuilder.QueueTextureExtraction(RDGTexture, &CarvedVolume);
+				GraphBuilder.Execute();
+
+				RHICmdList.Read3DSurfaceFloatData(CarvedVolume->GetRHI(), FIntRect(0, 0, Resolution.X, Resolution.Y), FIntPoint(0, Resolution.Z), Readback);
+			}
+		);
+		FlushRenderingCommands();
+
+		OutVolume.SetNumUninitialized(Readback.Num());
+		for (int32 Index = 0; Index < Readback.Num(); ++Index)
+		{
+			const FLinearColor Color = Readback[Index].GetFloats();
+			OutVolume[Index] = FVector4f(Color.R, Color.G, Color.B, Color.A);
+		}
+		return true;
+	}
+
+	/** GPU carve must match the CPU reference mask at every voxel. */
+	bool TestGPUMatchesCPU(FAutomationTestBase& Test, const TArray<FIVSmokeHoleGPU>& Holes, const float Time, const TArray<FVector4f>& CPUVolume)
+	{
+		TArray<FVector4f> GPUVolume;
+		if (!CarveOnGPU(Holes, Time, GPUVolume))
+		{
+			Test.AddInfo(TEXT("No RHI, GPU carve comparison skipped."));
+			return true;
+		}
+		if (!Test.TestEqual(TEXT("GPU carve voxel count"), GPUVolume.Num(), CPUVolume.Num()))
+		{
+			return false;
+		}
+
+		int32 NumMismatches = 0;
+		for (int32 Index = 0; Index < CPUVolume.Num(); ++Index)
+		{
+			if (!FMath::IsNearlyEqual(GPUVolume[Index].W, CPUVolume[Index].W, GPUMaskTolerance) && NumMismatches++ == 0)
+			{
+				Test.AddError(FString::Printf(TEXT("GPU carve mask differs at voxel %d: %f, expected %f"),
+					Index, GPUVolume[Index].W, CPUVolume[Index].W));
+			}
+		}
+		return Test.TestEqual(TEXT("GPU carve mismatches"), NumMismatches, 0);
+	}
+
+	/** Binned and GPU comparisons shared by every hole type. */
+	void TestCarveConsistency(FAutomationTestBase& Test, const TArray<FIVSmokeHoleGPU>& Holes, const float Time)
+	{
+		const FIVSmokeHoleCarveCPU Carve(Holes, TArray<float>(), VolumeMin, VolumeMax);
+		TArray<FVector4f> CPUVolume;
+		if (TestCarveMatchesEvaluate(Test, Carve, Time, CPUVolume))
+		{
+			TestGPUMatchesCPU(Test, Holes, Time, CPUVolume);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIVSmokeHoleCarveExplosionTest, "IVSmoke.Hole.Carve.Explosion",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FIVSmokeHoleCarveExplosionTest::RunTest(const FString& Parameters)
+{
+	using namespace IVSmokeHoleCarveTests;
+
+	FIVSmokeHoleGPU Hole = MakeHole(EIVSmokeHoleType::Explosion);
+	Hole.Position = FVector3f(200.0f, 200.0f, 250.0f);
+	Hole.Radius = 100.0f;
+	Hole.Softness = 0.2f;
+	Hole.Duration = 10.0f;
+	Hole.ExpansionDuration = 1.0f;
+	Hole.DistortionExpOverTime = 1.0f;
+	Hole.DistortionDistance = 20.0f;
+	const TArray<FIVSmokeHoleGPU> Holes = { Hole };
+
+	const FIVSmokeHoleCarveCPU Carve(Holes, TArray<float>(), VolumeMin, VolumeMax);
+	TestMask(*this, TEXT("Center at full expansion is carved"), Carve, Hole.Position, 0.99f, 0.0f, 1e-3f);
+	TestMask(*this, TEXT("Outside the radius is untouched"), Carve, Hole.Position + FVector3f(150.0f, 0.0f, 0.0f), 0.99f, 1.0f, 1e-3f);
+	TestMask(*this, TEXT("Center before spawn is untouched"), Carve, Hole.Position, 0.0f, 1.0f, 1e-3f);
+	TestMask(*this, TEXT("Expired hole is untouched"), Carve, Hole.Position, 11.0f, 1.0f, 1e-3f);
+
+	TestCarveConsistency(*this, Holes, 0.5f);
+	TestCarveConsistency(*this, Holes, 5.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIVSmokeHoleCarvePenetrationTest, "IVSmoke.Hole.Carve.Penetration",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FIVSmokeHoleCarvePenetrationTest::RunTest(const FString& Parameters)
+{
+	using namespace IVSmokeHoleCarveTests;
+
+	FIVSmokeHoleGPU Hole = MakeHole(EIVSmokeHoleType::Penetration);
+	Hole.Position = FVector3f(0.0f, 200.0f, 200.0f);
+	Hole.EndPosition = FVector3f(400.0f, 200.0f, 200.0f);
+	Hole.Radius = 50.0f;
+	Hole.EndRadius = 30.0f;
+	Hole.Softness = 0.2f;
+	Hole.Duration = 10.0f;
+	const TArray<FIVSmokeHoleGPU> Holes = { Hole };
+
+	const FIVSmokeHoleCarveCPU Carve(Holes, TArray<float>(), VolumeMin, VolumeMax);
+	TestMask(*this, TEXT("Axis is carved"), Carve, FVector3f(100.0f, 200.0f, 200.0f), 1.0f, 0.0f, 1e-2f);
+	TestMask(*this, TEXT("Beside the trajectory is untouched"), Carve, FVector3f(100.0f, 300.0f, 200.0f), 1.0f, 1.0f, 1e-3f);
+	TestMask(*this, TEXT("Beyond the end radius is untouched"), Carve, FVector3f(380.0f, 240.0f, 200.0f), 1.0f, 1.0f, 1e-3f);
+	TestMask(*this, TEXT("Expired hole is untouched"), Carve, FVector3f(100.0f, 200.0f, 200.0f), 11.0f, 1.0f, 1e-3f);
+
+	TestCarveConsistency(*this, Holes, 1.0f);
+	TestCarveConsistency(*this, Holes, 9.0f);
+
+	// The penetration span is padded by a voxel past the active cells, so the capsule's flat ends leave no uncarved skin
+	const FIntVector GridResolution(8, 8, 8);
+	TArray<uint64> VoxelBits;
+	VoxelBits.SetNumZeroed(GridResolution.Y * GridResolution.Z);
+	for (int32 X = 2; X <= 5; ++X)
+	{
+		UIVSmokeGridLibrary::SetVoxelBit(VoxelBits, FIntVector(X, 4, 4), GridResolution, true);
+	}
+	const FVector GridOrigin(-2.0, 4.5, 4.5);
+	const FVector GridDirection(1.0, 0.0, 0.0);
+	double Entry = 0.0;
+	double Exit = 0.0;
+	if (TestTrue(TEXT("Span hits the active cells"), UIVSmokeGridLibrary::TraceVoxelBitSpan(VoxelBits, GridResolution, GridOrigin, GridDirection, 0.0, 12.0, 1.0, Entry, Exit)))
+	{
+		TestEqual(TEXT("Span entry is one voxel before the first active cell"), Entry, 3.0, 1e-6);
+		TestEqual(TEXT("Span exit is one voxel after the last active cell"), Exit, 9.0, 1e-6);
+	}
+	if (UIVSmokeGridLibrary::TraceVoxelBitSpan(VoxelBits, GridResolution, GridOrigin, GridDirection, 0.0, 12.0, 10.0, Entry, Exit))
+	{
+		TestEqual(TEXT("Padded entry is clamped to the slab span"), Entry, 0.0, 1e-6);
+		TestEqual(TEXT("Padded exit is clamped to the slab span"), Exit, 12.0, 1e-6);
+	}
+	TestFalse(TEXT("Span misses a row without active cells"), UIVSmokeGridLibrary::TraceVoxelBitSpan(VoxelBits, GridResolution, FVector(-2.0, 1.5, 4.5), GridDirection, 0.0, 12.0, 1.0, Entry, Exit));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FIVSmokeHoleCarveDynamicTest, "IVSmoke.Hole.Carve.Dynamic",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FIVSmokeHoleCarveDynamicTest::RunTest(const FString& Parameters)
+{
+	using namespace IVSmokeHoleCarveTests;
+
+	FIVSmokeHoleGPU Hole = MakeHole(EIVSmokeHoleType::Dynamic);
+	Hole.Position = FVector3f(150.0f, 200.0f, 200.0f);
+	Hole.EndPosition = FVector3f(250.0f, 200.0f, 200.0f);
+	Hole.Extent = FVector3f(100.0f, 100.0f, 100.0f);
+	Hole.Softness = 0.5f;
+	Hole.Duration = 10.0f;
+	const TArray<FIVSmokeHoleGPU> Holes = { Hole };
+
+	const FIVSmokeHoleCarveCPU Carve(Holes, TArray<float>(), VolumeMin, VolumeMax);
+	TestMask(*this, TEXT("Trajectory center is carved"), Carve, FVector3f(200.0f, 200.0f, 200.0f), 1.0f, 0.01f, 1e-3f);
+	TestMask(*this, TEXT("Above the capsule is untouched"), Carve, FVector3f(200.0f, 200.0f, 350.0f), 1.0f, 1.0f, 1e-3f);
+	TestMask(*this, TEXT("Expired hole is untouched"), Carve, FVector3f(200.0f, 200.0f, 200.0f), 11.0f, 1.0f, 1e-3f);
+
+	// Overlapping holes of every type, so the combination order is covered as well
+	FIVSmokeHoleGPU Penetration = MakeHole(EIVSmokeHoleType::Penetration);
+	Penetration.Position = FVector3f(200.0f, 0.0f, 200.0f);
+	Penetration.EndPosition = FVector3f(200.0f, 400.0f, 200.0f);
+	Penetration.Radius = 40.0f;
+	Penetration.EndRadius = 40.0f;
+	Penetration.Softness = 0.2f;
+	Penetration.Duration = 10.0f;
+
+	TestCarveConsistency(*this, Holes, 1.0f);
+	TestCarveConsistency(*this, { Hole, Penetration }, 1.0f);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -20,8 +20,16 @@ DECLARE_STATS_GROUP(TEXT("IVSmoke"), STATGROUP_IVSmoke, STATCAT_Advanced);
 DECLARE_MEMORY_STAT(TEXT("Noise Volume"), STAT_IVSmoke_NoiseVolume, STATGROUP_IVSmoke);
 DECLARE_MEMORY_STAT(TEXT("CSM Shadow Maps"), STAT_IVSmoke_CSMShadowMaps, STATGROUP_IVSmoke);
 DECLARE_MEMORY_STAT(TEXT("Per-Frame Textures"), STAT_IVSmoke_PerFrameTextures, STATGROUP_IVSmoke);
+DECLARE_MEMORY_STAT(TEXT("Hole Atlas"), STAT_IVSmoke_HoleAtlas, STATGROUP_IVSmoke);
+DECLARE_MEMORY_STAT(TEXT("Voxel Atlas"), STAT_IVSmoke_VoxelAtlas, STATGROUP_IVSmoke);
 DECLARE_MEMORY_STAT(TEXT("Total VRAM"), STAT_IVSmoke_TotalVRAM, STATGROUP_IVSmoke);
 
+//~==============================================================================
+// Dynamic Resolution Stats
+
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Ray March Resolution Scale"), STAT_IVSmoke_RayMarchResolutionScale, STATGROUP_IVSmoke);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Pre-Pass GPU Time (ms)"), STAT_IVSmoke_PrePassGPUTime, STATGROUP_IVSmoke);
+
 class FIVSmokeModule : public IModuleInterface
 {
 public:
@@ -17,7 +17,7 @@ class UWorld;
  * Data for a single shadow cascade.
  * Contains render targets, matrices, and update state.
  *
- * TIMING MODEL (Synchronous Capture):
+ * TIMING MODEL (Synchronous, Staggered Capture):
  * ============================================================================
  * We use manual CaptureScene() calls instead of bCaptureEveryFrame to ensure
  * VP matrix and depth texture are always synchronized within the same frame.
@@ -26,6 +26,11 @@ class UWorld;
  *   1. Game Thread: Update() calculates VP_N and calls CaptureScene()
  *   2. Render Thread: Pre-pass ray march uses VP_N with Depth_N ✓
  *   3. Render Thread: Post-process composite
+ *
+ * With priority update, a cascade skipped in frame N keeps VP_K and Depth_K
+ * from its last capture K. Both are only written together, so sampling stays
+ * consistent. Coverage padding keeps the split sphere of the current camera
+ * inside the stale capture until the cascade is due again.
  * ============================================================================
  */
 struct IVSMOKE_API FIVSmokeCascadeData
@@ -38,7 +43,7 @@ struct IVSMOKE_API FIVSmokeCascadeData
 	float FarPlane = 0.0f;
 
 	//~==============================================================================
-	// Current Frame Values (used for both capture and shader sampling)
+	// Capture-Time Values (written only with a capture, used for shader sampling)
 
 	/** Orthographic projection width for this cascade. */
 	float OrthoWidth = 0.0f;
@@ -52,6 +57,15 @@ struct IVSMOKE_API FIVSmokeCascadeData
 	/** Light camera forward direction (light travel direction, opposite of light source). */
 	FVector LightCameraForward = FVector(0.0f, 0.0f, -1.0f);
 
+	/** Main camera position the capture was centered on. */
+	FVector CaptureCameraPosition = FVector::ZeroVector;
+
+	/** Direction toward the light at capture. */
+	FVector CaptureLightDirection = FVector::ZeroVector;
+
+	/** Light space box covered by the capture (right, up, toward light). Used when fitting to smoke. */
+	FBox CaptureBounds = FBox(ForceInit);
+
 	//~==============================================================================
 	// Resources
 
@@ -67,8 +81,14 @@ struct IVSMOKE_API FIVSmokeCascadeData
 	/** Whether this cascade needs capture this frame. */
 	bool bNeedsCapture = true;
 
+	/** Light space box of the smoke within this cascade's split range this frame. Invalid when there is none. */
+	FBox SmokeBounds = FBox(ForceInit);
+
 	/** Frame number when last captured. */
 	uint32 LastCaptureFrame = 0;
+
+	/** Whether the capture-time values hold a capture. */
+	bool bHasCapture = false;
 };
 
 /**
@@ -100,7 +120,8 @@ static_assert(sizeof(FIVSmokeCSMGPUData) == 80, "FIVSmokeCSMGPUData size must be
  * - Configurable cascade count (1-8)
  * - Log/Linear split distribution
  * - Texel snapping for shimmer prevention
- * - Priority-based update (near cascades update more frequently)
+ * - Optional fitting to the smoke volumes in each split range
+ * - Priority-based update (near cascades update more frequently, staggered across frames)
  * - VSM support for soft shadows
  */
 class IVSMOKE_API FIVSmokeCSMRenderer
@@ -140,12 +161,14 @@ public:
 	 * @param CameraForward  Camera forward direction.
 	 * @param LightDirection Direction TOWARD the light source (opposite of light travel).
 	 * @param FrameNumber	Current frame number for priority update.
+	 * @param SmokeBounds	World bounds of the rendered smoke volumes, cascades are fitted to them.
 	 */
 	void Update(
 		const FVector& CameraPosition,
 		const FVector& CameraForward,
 		const FVector& LightDirection,
-		uint32 FrameNumber
+		uint32 FrameNumber,
+		TConstArrayView<FBox> SmokeBounds
 	);
 
 	//~==============================================================================
@@ -216,10 +239,38 @@ private:
 
 	/**
 	 * Determine which cascades need update based on priority.
+	 * Cascade i is captured every Lerp(Near, Far, i / (N-1)) frames, offset by i so captures spread over frames.
+	 * A cascade is captured early when it has no capture, the light turned, or the camera left its padding
+	 * (fitted cascades: the smoke left the captured box). Fitted cascades without smoke are never captured.
 	 *
-	 * @param FrameNumber Current frame number.
+	 * @param FrameNumber	Current frame number.
+	 * @param CameraPosition Camera world position.
+	 * @param LightDirection Direction TOWARD the light source.
+	 * @param SmokeBounds	World bounds of the rendered smoke volumes.
 	 */
-	void UpdateCascadePriorities(uint32 FrameNumber);
+	void UpdateCascadePriorities(uint32 FrameNumber, const FVector& CameraPosition, const FVector& LightDirection, TConstArrayView<FBox> SmokeBounds);
+
+	/**
+	 * Light space box of the smoke a cascade is sampled for: smoke bounds clipped to the cascade's
+	 * split range, from the start of the blend with the previous cascade to its own split distance.
+	 */
+	FBox ComputeCascadeSmokeBounds(
+		const FIVSmokeCascadeData& Cascade,
+		const FVector& CameraPosition,
+		const FVector& LightRight,
+		const FVector& LightUp,
+		const FVector& LightDirection,
+		TConstArrayView<FBox> SmokeBounds
+	) const;
+
+	/** Light view axes for a normalized direction toward the light. Shared by every cascade. */
+	static void ComputeLightBasis(const FVector& LightDirection, FVector& OutLightRight, FVector& OutLightUp);
+
+	/** Frames between scheduled captures of a cascade (1 = every frame). */
+	int32 GetCaptureInterval(int32 CascadeIndex) const;
+
+	/** Ortho width factor over the cascade's split distance. Only cascades that can go stale are padded. */
+	float GetCoverageScale(int32 CascadeIndex) const { return GetCaptureInterval(CascadeIndex) > 1 ? 1.0f + CoveragePadding : 1.0f; }
 
 	/**
 	 * Update a single cascade's capture settings.
@@ -283,7 +334,7 @@ private:
 	bool bIsInitialized = false;
 
 	/** Enable priority-based updates. */
-	bool bEnablePriorityUpdate = true;
+	bool bEnablePriorityUpdate = false;
 
 	/** Near cascade update interval (frames). */
 	int32 NearCascadeUpdateInterval = 1;
@@ -291,6 +342,21 @@ private:
 	/** Far cascade update interval (frames). */
 	int32 FarCascadeUpdateInterval = 4;
 
+	/** Extra ortho width around each split distance, fraction of the split distance. */
+	float CoveragePadding = 0.1f;
+
+	/** Fit cascades to the smoke in their split range. */
+	bool bFitToSmoke = false;
+
+	/** Cascade blend region, the previous cascade's split range blends into each cascade. */
+	float CascadeBlendRange = 0.1f;
+
+	/** Smallest fitted ortho width, keeps tiny volumes from getting sub-centimeter texels. */
+	static constexpr float MinFittedOrthoWidth = 200.0f;
+
+	/** Cosine of the light rotation that re-captures every cascade (~0.5 degrees). */
+	static constexpr float LightRecaptureCosine = 0.99996f;
+
 	/** Main camera position (stored for camera-relative calculations). */
 	FVector MainCameraPosition = FVector::ZeroVector;
 };
@@ -104,6 +104,52 @@ public:
 		return InvalidGridPos;
 	}
 
+	/**
+	 * Ray vs axis-aligned box slab test. The hit span is clamped to start at the ray origin.
+	 *
+	 * @param BoxMin			Box minimum.
+	 * @param BoxMax			Box maximum.
+	 * @param Origin			Ray origin.
+	 * @param Direction			Ray direction. Not required to be normalized; T is in units of Direction.
+	 * @param OutTNear			Ray parameter where the ray enters the box (0 if it starts inside).
+	 * @param OutTFar			Ray parameter where the ray leaves the box.
+	 * @return					True if the ray hits the box.
+	 */
+	static FORCEINLINE bool RayBoxIntersection(const FVector& BoxMin, const FVector& BoxMax, const FVector& Origin, const FVector& Direction, double& OutTNear, double& OutTFar)
+	{
+		OutTNear = 0.0;
+		OutTFar = TNumericLimits<double>::Max();
+
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			if (FMath::IsNearlyZero(Direction[Axis]))
+			{
+				if (Origin[Axis] < BoxMin[Axis] || Origin[Axis] > BoxMax[Axis])
+				{
+					return false;
+				}
+				continue;
+			}
+
+			const double InvDirection = 1.0 / Direction[Axis];
+			double T0 = (BoxMin[Axis] - Origin[Axis]) * InvDirection;
+			double T1 = (BoxMax[Axis] - Origin[Axis]) * InvDirection;
+			if (T0 > T1)
+			{
+				Swap(T0, T1);
+			}
+
+			OutTNear = FMath::Max(OutTNear, T0);
+			OutTFar = FMath::Min(OutTFar, T1);
+			if (OutTNear > OutTFar)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
 	//~==============================================================================
 	// Bitmask Helpers
 
@@ -242,4 +288,25 @@ public:
 
 		VoxelBitArray[Index] ^= (1ULL << GridPos.X);
 	}
+
+	//~==============================================================================
+	// Ray Traversal
+
+	/**
+	 * Finds the span of a grid-space ray that passes through set voxel bits, with a 3D DDA from the first to the last set
+	 * voxel it crosses. Voxel G covers [G, G + 1). The span is padded by Padding on both ends, clamped to [TStart, TEnd].
+	 *
+	 * @param VoxelBitArray		Bit-packed voxel occupancy array (uint64 per YZ slice).
+	 * @param Resolution		3D grid resolution (each axis < 64).
+	 * @param GridOrigin		Ray origin in grid space.
+	 * @param GridDirection		Ray direction in grid space. T is in the caller's units, e.g. world units for a world-normalized direction.
+	 * @param TStart			Start of the ray span to search.
+	 * @param TEnd				End of the ray span to search.
+	 * @param Padding			Distance added before the first and after the last set voxel.
+	 * @param OutEntryDistance	Padded T where the ray enters the set voxels.
+	 * @param OutExitDistance	Padded T where the ray leaves the set voxels.
+	 * @return					True if the ray crosses any set voxel.
+	 */
+	static bool TraceVoxelBitSpan(const TArray<uint64>& VoxelBitArray, const FIntVector& Resolution, const FVector& GridOrigin, const FVector& GridDirection,
+		double TStart, double TEnd, double Padding, double& OutEntryDistance, double& OutExitDistance);
 };
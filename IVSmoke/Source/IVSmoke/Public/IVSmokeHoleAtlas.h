@@ -0,0 +1,140 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphResources.h"
+
+class FRDGBuilder;
+
+/**
+ * @struct FIVSmokeHoleAtlasLayout
+ * @brief Slot grid of the persistent hole atlas. Every slot has the same resolution
+ *        and slots are separated by SlotInterval voxels of "no hole" padding.
+ */
+struct IVSMOKE_API FIVSmokeHoleAtlasLayout
+{
+	/** Resolution of a single slot. Zero until the first slot is allocated. */
+	FIntVector SlotResolution = FIntVector::ZeroValue;
+
+	/** Number of slots per axis. */
+	FIntVector SlotCount = FIntVector(1, 1, 1);
+
+	/** PF_FloatRGBA (distortion + mask), or PF_G8 / PF_G16 for compact masks. */
+	EPixelFormat Format = PF_FloatRGBA;
+
+	bool IsValid() const { return SlotResolution.X > 0 && SlotResolution.Y > 0 && SlotResolution.Z > 0; }
+	bool IsCompact() const { return Format != PF_FloatRGBA; }
+	int32 GetCapacity() const { return SlotCount.X * SlotCount.Y * SlotCount.Z; }
+
+	/** Full atlas texture resolution. */
+	FIntVector GetAtlasResolution() const;
+
+	/** Texel offset of Slot inside the atlas. */
+	FIntVector GetSlotOffset(const int32 Slot) const;
+
+	bool operator==(const FIVSmokeHoleAtlasLayout& Other) const
+	{
+		return SlotResolution == Other.SlotResolution && SlotCount == Other.SlotCount && Format == Other.Format;
+	}
+	bool operator!=(const FIVSmokeHoleAtlasLayout& Other) const { return !(*this == Other); }
+};
+
+/**
+ * @class FIVSmokeHoleAtlas
+ * @brief Persistent 3D atlas holding the hole volume of every hole generator in a stable slot.
+ *        Slots are allocated and freed on the game thread as hole generators get their first hole and lose their last.
+ *        Capacity doubles when exhausted and halves down again once the live slots fit a quarter of it.
+ *        The atlas textures are owned by the render thread and only written by hole carves,
+ *        so the ray march binds them directly without any per-frame clear or copy.
+ */
+class IVSMOKE_API FIVSmokeHoleAtlas
+{
+public:
+	static FIVSmokeHoleAtlas& Get();
+
+	/** Padding between slots, matches the voxel atlas packing. */
+	static constexpr int32 SlotInterval = 4;
+
+	/** Maximum atlas size per axis. */
+	static constexpr int32 MaxAtlasSize = 2048;
+
+	/** Initial slot capacity. Capacity doubles when exhausted. */
+	static constexpr int32 MinCapacity = 8;
+
+	//~============================================================================
+	// Game Thread
+#pragma region Game Thread
+public:
+	/**
+	 * Allocate a slot. The atlas is re-laid out when the slot resolution grows, the format changes
+	 * or capacity is exhausted. Slot indices stay valid across re-layouts. A capacity change copies every
+	 * live slot into the new atlas, a new slot resolution or format loses slot contents and owners re-carve.
+	 * @return Slot index, or INDEX_NONE if the atlas is full.
+	 */
+	int32 AllocateSlot(const FIntVector& Resolution, const EPixelFormat Format);
+
+	/** Free a slot and clear it to "no hole". Trailing free slots are trimmed and the atlas shrinks when mostly unused. */
+	void FreeSlot(const int32 Slot);
+
+	/** Clear a slot to "no hole" without freeing it. */
+	void ClearSlot(const int32 Slot);
+
+	/** Change the mask format of the whole atlas. All slot contents are lost. */
+	void SetFormat(const EPixelFormat Format);
+
+	/** Mark whether Slot carries compact distortion. The distortion atlas only exists while any slot does. */
+	void SetSlotDistortion(const int32 Slot, const bool bHasDistortion);
+
+	/** Layout as seen by the game thread. */
+	const FIVSmokeHoleAtlasLayout& GetLayout() const { return Layout; }
+
+	/** Release all atlas textures on the render thread. Slot allocations are kept and re-cleared on next use. */
+	void Release();
+#pragma endregion
+
+	//~============================================================================
+	// Render Thread
+#pragma region Render Thread
+public:
+	/** Layout the render thread textures are built with. */
+	const FIVSmokeHoleAtlasLayout& GetLayout_RenderThread() const { return RenderLayout; }
+
+	/** Register the mask atlas, creating it cleared to "no hole" if needed. nullptr when no slot was ever allocated. */
+	FRDGTextureRef RegisterMaskAtlas(FRDGBuilder& GraphBuilder);
+
+	/** Register the compact distortion atlas. nullptr unless the layout is compact and a slot carries distortion. */
+	FRDGTextureRef RegisterDistortionAtlas(FRDGBuilder& GraphBuilder);
+
+	/** GPU memory of the allocated atlas textures. */
+	int64 GetMemorySize_RenderThread() const;
+#pragma endregion
+
+private:
+	FIVSmokeHoleAtlas() = default;
+
+	/** Apply a new game thread layout and forward it to the render thread, copying live slots when only the capacity changes. */
+	void Relayout(const FIVSmokeHoleAtlasLayout& NewLayout);
+
+	/** Drop free slots at the end of the slot range and shrink the atlas to the remaining ones. */
+	void ShrinkToLiveSlots();
+
+	/** Forward distortion atlas usage to the render thread. */
+	void UpdateRenderDistortion();
+
+	/** Render thread: copy a cleared slot-sized volume over Slot. */
+	void ClearSlot_RenderThread(FRDGBuilder& GraphBuilder, const int32 Slot);
+
+	//~ Game thread state
+	FIVSmokeHoleAtlasLayout Layout;
+	TArray<int32> FreeSlots;
+	int32 NumAllocatedSlots = 0;
+	TBitArray<> DistortionSlots;
+	int32 NumDistortionSlots = 0;
+
+	//~ Render thread state
+	FIVSmokeHoleAtlasLayout RenderLayout;
+	bool bRenderDistortion = false;
+	TRefCountPtr<IPooledRenderTarget> MaskAtlas;
+	TRefCountPtr<IPooledRenderTarget> DistortionAtlas;
+};
@@ -39,7 +39,7 @@ struct IVSMOKE_API FIVSmokeHoleNoiseSettings
 
 /**
  * @struct FIVSmokeHoleDynamicSubject
- * @brief Dynamic hole generated type data structure
+ * @brief Dynamic hole generated type data structure, tracked by UIVSmokeHoleTrackerSubsystem.
  */
 USTRUCT()
 struct IVSMOKE_API FIVSmokeHoleDynamicSubject
@@ -50,6 +50,10 @@ struct IVSMOKE_API FIVSmokeHoleDynamicSubject
 	UPROPERTY(Transient)
 	TWeakObjectPtr<AActor> TargetActor;
 
+	/** Generator this subject is restricted to. Null creates holes in every smoke volume the actor passes through. */
+	UPROPERTY(Transient)
+	TWeakObjectPtr<UIVSmokeHoleGeneratorComponent> Generator;
+
 	/** Preset ID. */
 	UPROPERTY(Transient)
 	uint8 PresetID = 0;
@@ -66,6 +70,28 @@ struct IVSMOKE_API FIVSmokeHoleDynamicSubject
 	FORCEINLINE bool IsValid() const { return TargetActor.IsValid(); }
 };
 
+/**
+ * @struct FIVSmokePenetrationRequest
+ * @brief One penetration hole request of a batch sent through UIVSmokeHoleRequestComponent.
+ */
+USTRUCT(BlueprintType)
+struct IVSMOKE_API FIVSmokePenetrationRequest
+{
+	GENERATED_BODY()
+
+	/** Ray origin. */
+	UPROPERTY(BlueprintReadWrite, Category = "IVSmoke | Hole")
+	FVector3f Origin = FVector3f::ZeroVector;
+
+	/** Ray direction. Does not need to be normalized. */
+	UPROPERTY(BlueprintReadWrite, Category = "IVSmoke | Hole")
+	FVector3f Direction = FVector3f::ForwardVector;
+
+	/** Penetration preset. */
+	UPROPERTY(BlueprintReadWrite, Category = "IVSmoke | Hole")
+	TObjectPtr<UIVSmokeHolePreset> Preset;
+};
+
 /**
  * @struct FIVSmokeHoleData
  * @brief Network-optimized hole data structure.
@@ -106,6 +132,22 @@ public:
 
 	/** Check if this hole has expired. */
 	FORCEINLINE bool IsExpired(const float CurrentServerTime) const { return CurrentServerTime >= ExpirationServerTime; }
+
+	/**
+	 * Quantized serialization, only used through FIVSmokeHoleArray::NetDeltaSerialize.
+	 * Positions are sent as 16 bits per axis inside the owning volume's quantization bounds (full precision outside),
+	 * expiration as a wrapped 16-bit tick and PresetID bit-packed with the flags.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FIVSmokeHoleData> : public TStructOpsTypeTraitsBase2<FIVSmokeHoleData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
 };
 
 /**
@@ -124,35 +166,49 @@ private:
 	UPROPERTY(Transient, VisibleAnywhere, Category = "IVSmoke | Hole")
 	TArray<FIVSmokeHoleData> Items;
 
+	/** Expiry index entry, keyed by the item's ReplicationID. */
+	struct FExpiryEntry
+	{
+		float ExpirationServerTime;
+		int32 ReplicationID;
+
+		FORCEINLINE bool operator<(const FExpiryEntry& Other) const { return ExpirationServerTime < Other.ExpirationServerTime; }
+	};
+
+	/**
+	 * Min-heap over ExpirationServerTime. Authority only, never replicated.
+	 * Entries of removed holes are left in place and skipped once they reach the top.
+	 */
+	TArray<FExpiryEntry> ExpiryHeap;
+
+	/** ReplicationID -> Items index. Authority only. */
+	TMap<int32, int32> ItemIndices;
+
+	/** Discard stale heap entries and return the index of the earliest expiring hole, or INDEX_NONE. */
+	int32 GetEarliestExpiringIndex();
+
 public:
 	/** Owner component reference for replication callbacks. */
 	UPROPERTY(Transient, NotReplicated)
 	TObjectPtr<UIVSmokeHoleGeneratorComponent> OwnerComponent;
 
-	/** FastArray delta replication entry point. */
-	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
-	{
-		return FFastArraySerializer::FastArrayDeltaSerialize<FIVSmokeHoleData, FIVSmokeHoleArray>(
-			Items, DeltaParms, *this
-		);
-	}
+	/** FastArray delta replication entry point. Provides the quantization context for FIVSmokeHoleData::NetSerialize. */
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
 
-	/** Add new hole and mark dirty. */
-	void AddHole(const FIVSmokeHoleData& NewHole)
-	{
-		Items.Add(NewHole);
-		MarkItemDirty(Items.Last());
-	}
+	/** Add new hole, index its expiration and mark dirty. O(log n). */
+	void AddHole(const FIVSmokeHoleData& NewHole);
+
+	/** Overwrite the earliest expiring hole with NewHole and mark it dirty. O(log n). */
+	void ReplaceEarliestExpiringHole(const FIVSmokeHoleData& NewHole);
+
+	/**
+	 * Remove every hole expired at CurrentServerTime. Only due holes are visited.
+	 * @return Number of removed holes.
+	 */
+	int32 RemoveExpiredHoles(const float CurrentServerTime);
 
 	/** Remove hole by swap and mark dirty. */
-	void RemoveAtSwap(const int32 Index)
-	{
-		if (Items.IsValidIndex(Index))
-		{
-			Items.RemoveAtSwap(Index);
-			MarkArrayDirty();
-		}
-	}
+	void RemoveAtSwap(const int32 Index);
 
 	/** Returns the hole num */
 	FORCEINLINE int32 Num() const { return Items.Num(); }
@@ -172,8 +228,12 @@ public:
 	/** Empty items array and mark dirty. */
 	void Empty();
 
-	/** Converts items array into an array of GPU-compatible hole data structures. */
-	TArray<FIVSmokeHoleGPU> GetHoleGPUData(const float CurrentServerTime) const;
+	/**
+	 * Converts items array into an array of GPU-compatible hole data structures.
+	 * The result is time-independent, so it only needs to be rebuilt when holes are added or removed.
+	 * @param OutCurveLUT	Fade range curves referenced by the holes, sampled at FIVSmokeHoleCarveCS::CurveLUTSize points each.
+	 */
+	TArray<FIVSmokeHoleGPU> GetHoleGPUData(TArray<float>& OutCurveLUT) const;
 };
 
 // Enable delta serialization for FIVSmokeHoleArray
@@ -7,7 +7,6 @@
 #include "IVSmokeHoleGeneratorComponent.generated.h"
 
 class UTexture2D;
-class UTextureRenderTargetVolume;
 class UIVSmokeHolePreset;
 
 /**
@@ -40,48 +39,90 @@ public:
 	/** Create penetration hole. Called on server via UIVSmokeHoleRequestComponent. */
 	void CreatePenetrationHole(const FVector3f& Origin, const FVector3f& Direction, const uint8 PresetID);
 
+	/**
+	 * Create a batch of penetration holes. Called on server via UIVSmokeHoleRequestComponent.
+	 * Rays are clipped to the active smoke analytically and near-duplicate hits of the same preset are coalesced into one hole.
+	 */
+	void CreatePenetrationHoles(TConstArrayView<FIVSmokePenetrationRequest> Requests);
+
 	/** Create explosion hole. Called on server via UIVSmokeHoleRequestComponent. */
 	void CreateExplosionHole(const FVector3f& Origin, const uint8 PresetID);
 
-	/** Register dynamic object. Called on server via UIVSmokeHoleRequestComponent. */
+	/** Register dynamic object with the world's UIVSmokeHoleTrackerSubsystem. Called on server via UIVSmokeHoleRequestComponent. */
 	void RegisterTrackDynamicHole(AActor* TargetActor, const uint8 PresetID);
+
+	/** Create a batch of dynamic holes. Called on server by UIVSmokeHoleTrackerSubsystem. */
+	void CreateDynamicHoles(TConstArrayView<FIVSmokeHoleData> Holes);
+
+	/**
+	 * Get the hole density mask at a world position, evaluated on the CPU with FIVSmokeHoleCarveCPU.
+	 * Works without a renderer (dedicated servers), e.g. for line of sight checks through holes.
+	 * @return 1 = no hole, 0 = fully carved. Edge noise and blur are not applied.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IVSmoke | Hole | API")
+	float GetHoleDensityAt(const FVector& WorldPosition) const;
 #pragma endregion
 
 	//~============================================================================
 	// Authority Only (Server & Standalone)
 #pragma region Authority Only
 private:
-
-	UPROPERTY(Transient)
-	TArray<FIVSmokeHoleDynamicSubject> DynamicSubjectList;
-
 	/** Create hole data to be rendered by GPU. (todo: must be refactored) */
 	void Authority_CreateHole(const FIVSmokeHoleData& HoleData);
 
 	/** Clean up expired hole data and notify GPU to be updated. */
 	void Authority_CleanupExpiredHoles();
 
-	/** Calculate penetration entry & exit points via raycast. */
+	/** Calculate penetration entry & exit points through the active smoke, then clip them by obstacles. */
 	bool Authority_CalculatePenetrationPoints(const FVector3f& Origin, const FVector3f& Direction, const float BulletThickness, FVector3f& OutEntry, FVector3f& OutExit);
 
-	/** Manage the dynamic object's life cycle and update dynamic hole. */
-	void Authority_UpdateDynamicSubjectList();
+	/**
+	 * Calculate where a ray enters and leaves the owner's active smoke without any physics query.
+	 * Falls back to a slab test against the box when the owner is not a voxel volume.
+	 */
+	bool Authority_ClipRayToSmoke(const FVector3f& Origin, const FVector3f& Direction, FVector3f& OutEntry, FVector3f& OutExit) const;
+
+	/** Pull the exit point back to the first obstacle between entry and exit. */
+	void Authority_ClipPenetrationByObstacles(const FVector3f& Entry, const float BulletThickness, FVector3f& InOutExit) const;
 #pragma endregion
 
 	//~============================================================================
 	// Local Only (Client & Standalone)
 #pragma region Local Only
 private:
-	UPROPERTY(Transient)
-	TObjectPtr<UTextureRenderTargetVolume> HoleTexture = nullptr;
+	/** Slot in the persistent FIVSmokeHoleAtlas this component carves into. Only allocated while holes are active. */
+	int32 HoleAtlasSlot = INDEX_NONE;
+
+	/** Distortion range the compact distortion atlas is encoded with (max DistortionDistance of active explosions). */
+	float HoleDistortionRange = 0.0f;
+
+	/** Whether this slot currently carries compact distortion (explosion holes are active). */
+	bool bHoleAtlasDistortion = false;
+
+	/** Set once a full atlas was reported for this component. Allocation is retried every tick, warn once until it succeeds. */
+	bool bHoleAtlasFullWarned = false;
+
+	/** Hole and curve LUT buffers kept alive across frames. Only touched on the render thread. */
+	TSharedPtr<FIVSmokeHoleGPUResources, ESPMode::ThreadSafe> HoleGPUResources;
 
-	/** Initialize 3D texture for hole data. */
-	void Local_InitializeHoleTexture();
+	/** Last uploaded hole data, kept on the game thread to re-bin holes when the volume bounds move. */
+	TArray<FIVSmokeHoleGPU> BinnedGPUHoles;
 
-	/** Clear hole texture to white. Called when all holes have expired. */
-	void Local_ClearHoleTexture();
+	/** Last uploaded curve LUT, matching BinnedGPUHoles. */
+	TArray<float> BinnedCurveLUT;
 
-	/** Rebuild entire hole texture from ActiveHoles. (todo: must be refactored) */
+	/** Volume bounds and resolution the current brick bins were built for. */
+	FVector3f BinnedVolumeMin = FVector3f::ZeroVector;
+	FVector3f BinnedVolumeMax = FVector3f::ZeroVector;
+	FIntVector BinnedResolution = FIntVector::ZeroValue;
+
+	/** Allocate this component's hole atlas slot if it has none. Called by the first rebuild with active holes. */
+	void Local_AllocateHoleAtlasSlot();
+
+	/** Free the hole atlas slot, which clears it to "no hole". Called when all holes have expired. */
+	void Local_FreeHoleAtlasSlot();
+
+	/** Rebuild the hole atlas slot from ActiveHoles. (todo: must be refactored) */
 	void Local_RebuildHoleTexture();
 #pragma endregion
 
@@ -123,8 +164,17 @@ public:
 	/** Get synchronized server time. */
 	float GetSyncedTime() const;
 
-	/** Get Texture as a UTextureRenderTargetVolume to write by. */
-	FTextureRHIRef GetHoleTextureRHI() const;
+	/**
+	 * Get the bounds hole positions are quantized against for replication.
+	 * Covers the owner's full voxel grid, so it does not change while the smoke expands and server and clients agree on it.
+	 */
+	FBox3f GetNetQuantizationBounds() const;
+
+	/** Get the hole atlas slot this component carves into. INDEX_NONE if none was allocated. */
+	FORCEINLINE int32 GetHoleAtlasSlot() const { return HoleAtlasSlot; }
+
+	/** Get distortion range the compact distortion atlas is encoded with. */
+	FORCEINLINE float GetHoleDistortionRange() const { return bHoleAtlasDistortion ? HoleDistortionRange : 0.0f; }
 
 	/** Set BoxExtent and Component Position to VoxelAABB Center. */
 	void SetBoxToVoxelAABB();
@@ -132,6 +182,12 @@ public:
 	/** Set Dirty flag whether GPU updates the texure. */
 	FORCEINLINE void MarkHoleTextureDirty(const bool bIsDirty = true) { bHoleTextureDirty = bIsDirty; }
 
+	/** Set Dirty flag whether the hole list changed and the GPU hole buffer must be re-uploaded. */
+	FORCEINLINE void MarkHoleBufferDirty() { bHoleBufferDirty = true; bHoleTextureDirty = true; bHoleDensityQueryDirty = true; ++HoleBufferGeneration; }
+
+	/** Get the number of hole list changes so far. Renderer caches built from the holes compare it. */
+	FORCEINLINE uint32 GetHoleBufferGeneration() const { return HoleBufferGeneration; }
+
 private:
 
 	/** These are the holes activated in this smoke volume.*/
@@ -140,5 +196,19 @@ private:
 
 	/** HoleTexture dirty flag. */
 	uint8 bHoleTextureDirty : 1;
+
+	/** Hole buffer dirty flag. Set only when holes are added, changed or removed. */
+	uint8 bHoleBufferDirty : 1;
+
+	/** Incremented with every MarkHoleBufferDirty. */
+	uint32 HoleBufferGeneration = 0;
+
+	/** HoleDensityQuery must be rebuilt from the hole list before the next GetHoleDensityAt. */
+	mutable uint8 bHoleDensityQueryDirty : 1;
+
+	/** CPU carve answering GetHoleDensityAt, built from the hole list and the volume bounds it was built with. */
+	mutable FIVSmokeHoleCarveCPU HoleDensityQuery;
+	mutable FVector3f HoleDensityQueryMin = FVector3f::ZeroVector;
+	mutable FVector3f HoleDensityQueryMax = FVector3f::ZeroVector;
 #pragma endregion
 };
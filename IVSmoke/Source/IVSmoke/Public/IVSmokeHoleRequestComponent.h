@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Components/ActorComponent.h"
+#include "IVSmokeHoleData.h"
 #include "IVSmokeHoleRequestComponent.generated.h"
 
 class UIVSmokeHoleGeneratorComponent;
@@ -21,6 +22,20 @@ class IVSMOKE_API UIVSmokeHoleRequestComponent : public UActorComponent
 public:
 	UIVSmokeHoleRequestComponent();
 
+protected:
+	virtual void TickComponent(const float DeltaTime, const ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+public:
+	/** Maximum number of requests the server accepts in one batch. */
+	static constexpr int32 MaxPenetrationBatchSize = 64;
+
+	/**
+	 * Seconds queued penetration requests are gathered before they are flushed.
+	 * Each flush sends one RPC for every generator with queued requests. 0 flushes every frame.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "IVSmoke | Hole", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float PenetrationBatchInterval = 0.1f;
+
 	/** Find RequestComponent on Instigator's Pawn or PlayerController. */
 	UFUNCTION(BlueprintCallable, Category = "IVSmoke | Hole | API")
 	static UIVSmokeHoleRequestComponent* GetHoleRequester(const APawn* Instigator);
@@ -29,6 +44,21 @@ public:
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "IVSmoke | Hole | API")
 	void RequestPenetrationHole(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const FVector3f& Origin, const FVector3f& Direction, UIVSmokeHolePreset* Preset);
 
+	/** Request a batch of penetration holes on one generator. Always executed on server. */
+	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "IVSmoke | Hole | API")
+	void RequestPenetrationHoles(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const TArray<FIVSmokePenetrationRequest>& Requests);
+
+	/**
+	 * Queue a penetration hole. Every PenetrationBatchInterval the queue is flushed with RequestPenetrationHoles,
+	 * one RPC for each generator that received requests (not one RPC for all of them). Use this for automatic weapons.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "IVSmoke | Hole | API")
+	void QueuePenetrationHole(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const FVector3f& Origin, const FVector3f& Direction, UIVSmokeHolePreset* Preset);
+
+	/** Send all queued penetration requests now. */
+	UFUNCTION(BlueprintCallable, Category = "IVSmoke | Hole | API")
+	void FlushPenetrationHoles();
+
 	/** Request an explosion hole. Always executed on server. */
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "IVSmoke | Hole | API")
 	void RequestExplosionHole(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, const FVector3f& Origin, UIVSmokeHolePreset* Preset);
@@ -36,4 +66,11 @@ public:
 	/** Request a dynamic hole. Always executed on server. */
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "IVSmoke | Hole | API")
 	void RequestDynamicHole(UIVSmokeHoleGeneratorComponent* IVSmokeHoleGeneratorComponent, AActor* TargetActor, UIVSmokeHolePreset* Preset);
+
+private:
+	/** Queued penetration requests per generator. */
+	TMap<TWeakObjectPtr<UIVSmokeHoleGeneratorComponent>, TArray<FIVSmokePenetrationRequest>> PendingPenetrationRequests;
+
+	/** Time since the pending requests were last flushed. */
+	float PenetrationBatchElapsed = 0.0f;
 };
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GlobalShader.h"
+#include "RenderGraphResources.h"
 #include "ShaderParameterStruct.h"
 
 class UIVSmokeHolePreset;
@@ -14,19 +15,20 @@ struct FIVSmokeHoleData;
 
 /**
  * @struct FIVSmokeHoleGPU
- * @brief Built from FIVSmokeHoleData + UIVSmokeHolePreset at render time.
+ * @brief Built from FIVSmokeHoleData + UIVSmokeHolePreset when the hole list changes.
+ *        Contains no time-dependent values; the carve shader evaluates lifetime from CurrentServerTime.
  */
 struct alignas(16) FIVSmokeHoleGPU
 {
 	FIVSmokeHoleGPU() = default;
 
 	/**
-	 * You can Constructs a FIVSmokeHoleGPU using DynamicHoleData, Preset, and server time.
+	 * You can Constructs a FIVSmokeHoleGPU using DynamicHoleData and Preset.
+	 * Curve LUT indices are left as INDEX_NONE and assigned by FIVSmokeHoleArray::GetHoleGPUData.
 	 * @param DynamicHoleData		Dynamic hole data.
 	 * @param Preset				HolePreset defined as DataAsset.
-	 * @param CurrentServerTime		The CurrentServerTime is obtained through the GetSyncedTime function.
 	 */
-	FIVSmokeHoleGPU(const FIVSmokeHoleData& DynamicHoleData, const UIVSmokeHolePreset& Preset, const float CurrentServerTime);
+	FIVSmokeHoleGPU(const FIVSmokeHoleData& DynamicHoleData, const UIVSmokeHolePreset& Preset);
 
 	//~============================================================================
 	// Common
@@ -34,8 +36,8 @@ struct alignas(16) FIVSmokeHoleGPU
 	/** The central point of hole creation. */
 	FVector3f Position;
 
-	/** Time after hole is called creation. */
-	float CurLifeTime;
+	/** Server time at which the hole was created. */
+	float SpawnServerTime;
 
 	/** 0 = Penetration, 1 = Explosion, 2 = Dynamic */
 	int HoleType;
@@ -63,11 +65,11 @@ struct alignas(16) FIVSmokeHoleGPU
 	/** Expansion time used only for Explosion. */
 	float ExpansionDuration;
 
-	/** Current fadeRange extracted from ExpansionFadeRangeCurveOverTime with values normalized to expansion time. */
-	float CurExpansionFadeRangeOverTime;
+	/** Row of ExpansionFadeRangeCurveOverTime in the curve LUT buffer. INDEX_NONE = linear. */
+	int32 ExpansionCurveIndex;
 
-	/** Current fadeRange extracted from ShrinkFadeRangeCurveOverTime with values normalized to shrink time. */
-	float CurShrinkFadeRangeOverTime;
+	/** Row of ShrinkFadeRangeCurveOverTime in the curve LUT buffer. INDEX_NONE = inverse linear. */
+	int32 ShrinkCurveIndex;
 
 	/** Exponential value of the calculation of the distortion value over expansion time. */
 	float DistortionExpOverTime;
@@ -87,6 +89,124 @@ struct alignas(16) FIVSmokeHoleGPU
 	float EndRadius;
 };
 
+/**
+ * @struct FIVSmokeHoleBrickBins
+ * @brief Hole-to-brick binning for the carve pass.
+ *        The volume is split into BrickSize^3 voxel bricks and every hole is listed in the bricks
+ *        its lifetime bounding volume overlaps, so each voxel only evaluates nearby holes.
+ *        Bounds are conservative over the whole hole lifetime, so bins only change with the hole list or volume bounds.
+ */
+struct IVSMOKE_API FIVSmokeHoleBrickBins
+{
+	/** Brick edge length in voxels. Matches the carve thread group size. */
+	static constexpr int32 BrickSize = 8;
+
+	/** Number of bricks per axis. */
+	FIntVector BrickCount = FIntVector::ZeroValue;
+
+	/** (Offset, Count) into BrickHoleIndices per brick. */
+	TArray<FUintVector2> BrickRanges;
+
+	/** Hole indices grouped by brick, kept in hole buffer order. */
+	TArray<uint32> BrickHoleIndices;
+
+	/** Linear indices of bricks overlapped by at least one hole. */
+	TArray<uint32> ActiveBricks;
+
+	/**
+	 * @brief Assign holes to the bricks their bounding volumes overlap.
+	 *        Penetration = capsule, Explosion = ellipsoid, Dynamic = oriented box.
+	 * @param Holes			GPU hole data in carve order
+	 * @param CurveLUT		Fade range curve LUT referenced by Holes
+	 * @param VolumeMin		World space min of the carved volume
+	 * @param VolumeMax		World space max of the carved volume
+	 * @param Resolution	Hole texture resolution
+	 */
+	void Build(const TArray<FIVSmokeHoleGPU>& Holes, const TArray<float>& CurveLUT,
+		const FVector3f& VolumeMin, const FVector3f& VolumeMax, const FIntVector& Resolution);
+};
+
+/**
+ * @struct FIVSmokeHoleCarveCPU
+ * @brief CPU port of IVSmokeHoleCarveCS.usf on the same FIVSmokeHoleGPU layout.
+ *        Golden reference for the carve shader (IVSmoke.Hole.Carve automation tests), and hole density queries
+ *        where no GPU carve exists (dedicated servers).
+ *        Edge noise is not evaluated, which matches the shader with a mid-grey noise texture or zero noise strength.
+ *        Keep in sync with IVSmokeHoleCarveCS.usf.
+ */
+struct IVSMOKE_API FIVSmokeHoleCarveCPU
+{
+	FIVSmokeHoleCarveCPU() = default;
+
+	/**
+	 * @param InHoles		GPU hole data in carve order
+	 * @param InCurveLUT	Fade range curve LUT referenced by InHoles
+	 * @param InVolumeMin	World space min of the carved volume
+	 * @param InVolumeMax	World space max of the carved volume
+	 */
+	FIVSmokeHoleCarveCPU(TArray<FIVSmokeHoleGPU> InHoles, TArray<float> InCurveLUT, const FVector3f& InVolumeMin, const FVector3f& InVolumeMax);
+
+	/**
+	 * @brief Evaluate every hole at a world position.
+	 * @return rgb = distortion offset, a = density mask (1 = no hole, 0 = fully carved)
+	 */
+	FVector4f Evaluate(const FVector3f& WorldPos, const float CurrentServerTime) const;
+
+	/**
+	 * @brief Carve a whole volume like the carve pass, before blur. Voxels are ordered X fastest.
+	 *        Only holes binned to a voxel's brick are evaluated, the same as on the GPU.
+	 */
+	void Carve(const FIntVector& Resolution, const float CurrentServerTime, TArray<FVector4f>& OutVolume) const;
+
+	FORCEINLINE bool HasHoles() const { return Holes.Num() > 0; }
+
+private:
+	TArray<FIVSmokeHoleGPU> Holes;
+	TArray<float> CurveLUT;
+	FVector3f VolumeMin = FVector3f::ZeroVector;
+	FVector3f VolumeMax = FVector3f::ZeroVector;
+
+	/** 0..Holes.Num()-1, the hole list of an unbinned evaluation. */
+	TArray<uint32> AllHoleIndices;
+
+	/** Evaluate the listed holes in order, like one carve thread. */
+	FVector4f EvaluateHoles(const FVector3f& WorldPos, const float CurrentServerTime, TConstArrayView<uint32> HoleIndices) const;
+
+	float SampleCurveLUT(const int32 CurveIndex, const float NormalizedTime, const float DefaultValue) const;
+	FVector4f Explosion(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const FVector3f& UVW, const float CurrentServerTime, float& OutFadePenetration, float& OutFadePenetrationTime) const;
+	FVector4f Penetration(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const float CurrentServerTime, float& OutHoleMakeTime) const;
+	float Dynamic(const FIVSmokeHoleGPU& Hole, const FVector3f& WorldPos, const float CurrentServerTime) const;
+};
+
+/**
+ * @struct FIVSmokeHoleGPUResources
+ * @brief Persistent hole buffers owned by the render thread.
+ *        Uploaded only when the hole list changes and reused by every carve until then.
+ */
+struct FIVSmokeHoleGPUResources
+{
+	/** StructuredBuffer<FIVSmokeHoleGPU>. */
+	TRefCountPtr<FRDGPooledBuffer> HoleBuffer;
+
+	/** StructuredBuffer<float> holding CurveLUTSize samples per referenced curve. */
+	TRefCountPtr<FRDGPooledBuffer> CurveLUTBuffer;
+
+	/** StructuredBuffer<uint2> (Offset, Count) into BrickHoleIndexBuffer per brick. */
+	TRefCountPtr<FRDGPooledBuffer> BrickRangeBuffer;
+
+	/** StructuredBuffer<uint> of hole indices grouped by brick. */
+	TRefCountPtr<FRDGPooledBuffer> BrickHoleIndexBuffer;
+
+	/** StructuredBuffer<uint> of non-empty bricks. One carve group is dispatched per entry. */
+	TRefCountPtr<FRDGPooledBuffer> ActiveBrickBuffer;
+
+	/** Number of bricks per axis the bins were built for. */
+	FIntVector BrickCount = FIntVector::ZeroValue;
+
+	/** Number of entries in ActiveBrickBuffer. */
+	int32 NumActiveBricks = 0;
+};
+
 /**
  * @brief Compute shader that carves holes into 3D volume texture.
  */
@@ -97,6 +217,9 @@ public:
 	static constexpr uint32 ThreadGroupSizeY = 8;
 	static constexpr uint32 ThreadGroupSizeZ = 8;
 	static constexpr const TCHAR* EventName = TEXT("IVSmokeHoleCarveCS");
+
+	/** Samples per fade range curve in the curve LUT buffer. */
+	static constexpr uint32 CurveLUTSize = 64;
 	DECLARE_GLOBAL_SHADER(FIVSmokeHoleCarveCS);
 	SHADER_USE_PARAMETER_STRUCT(FIVSmokeHoleCarveCS, FGlobalShader);
 
@@ -109,6 +232,15 @@ public:
 		// Input: Hole data buffer (unified structure)
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FIVSmokeHoleGPU>, HoleBuffer)
 
+		// Input: Fade range curves sampled at CurveLUTSize points each
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float>, CurveLUTBuffer)
+
+		// Input: Hole-to-brick bins
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint2>, BrickHoleRanges)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, BrickHoleIndices)
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint>, ActiveBricks)
+		SHADER_PARAMETER(FIntVector, BrickCount)
+
 		// Volume bounds (local space)
 		SHADER_PARAMETER(FVector3f, VolumeMin)
 		SHADER_PARAMETER(FVector3f, VolumeMax)
@@ -117,7 +249,7 @@ public:
 		SHADER_PARAMETER(FIntVector, Resolution)
 
 		// Hole parameters
-		SHADER_PARAMETER(int32, NumHoles)
+		SHADER_PARAMETER(float, CurrentServerTime)
 
 		// Noise textures (per HoleType)
 		SHADER_PARAMETER_TEXTURE(Texture2D, PenetrationNoiseTexture)
@@ -148,44 +280,70 @@ public:
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEX"), ThreadGroupSizeX);
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEY"), ThreadGroupSizeY);
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEZ"), ThreadGroupSizeZ);
+		OutEnvironment.SetDefine(TEXT("CURVE_LUT_SIZE"), CurveLUTSize);
 	}
 };
 
 /**
- * @brief Compute shader for 1D separable blur on 3D volume texture.
- *        Run 3 times (X, Y, Z axis) for full 3D Gaussian blur.
+ * @brief Compute shader that writes the carved RGBA16F hole volume into its hole atlas slot.
+ *        Copies as-is for the full format. Compact formats write the density mask to the R8/R16 atlas
+ *        and, when explosions are active, the encoded distortion vector to the RGB10A2 atlas.
+ *        With FUSED_BLUR, each group first blurs its 8^3 tile along X, Y and Z in groupshared memory,
+ *        so blur and atlas write take a single dispatch.
  */
-class IVSMOKE_API FIVSmokeHoleBlurCS : public FGlobalShader
+class IVSMOKE_API FIVSmokeHolePackCS : public FGlobalShader
 {
 public:
 	static constexpr uint32 ThreadGroupSizeX = 8;
 	static constexpr uint32 ThreadGroupSizeY = 8;
 	static constexpr uint32 ThreadGroupSizeZ = 8;
-	static constexpr const TCHAR* EventName = TEXT("IVSmokeHoleBlurCS");
-	DECLARE_GLOBAL_SHADER(FIVSmokeHoleBlurCS);
-	SHADER_USE_PARAMETER_STRUCT(FIVSmokeHoleBlurCS, FGlobalShader);
+	static constexpr const TCHAR* EventName = TEXT("IVSmokeHolePackCS");
+	DECLARE_GLOBAL_SHADER(FIVSmokeHolePackCS);
+	SHADER_USE_PARAMETER_STRUCT(FIVSmokeHolePackCS, FGlobalShader);
+
+	class FCompactMaskDim : SHADER_PERMUTATION_BOOL("COMPACT_MASK");
+	class FWriteDistortionDim : SHADER_PERMUTATION_BOOL("WRITE_DISTORTION");
+	class FFusedBlurDim : SHADER_PERMUTATION_BOOL("FUSED_BLUR");
+	using FPermutationDomain = TShaderPermutationDomain<FCompactMaskDim, FWriteDistortionDim, FFusedBlurDim>;
+
+	/** Largest blur radius in voxels. Sizes the groupshared apron. */
+	static constexpr int32 MaxBlurStep = 4;
 
 public:
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
-		// Input: Source volume texture
+		// Input: Carved hole volume (rgb = distortion, a = density mask)
 		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D<float4>, InputTexture)
-		SHADER_PARAMETER_SAMPLER(SamplerState, InputSampler)
 
-		// Output: Destination volume texture
-		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, OutputTexture)
+		// Output: Hole atlas (RGBA16F), !COMPACT_MASK only
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, HoleTexture)
+
+		// Output: Density mask atlas (R8 / R16 UNORM), COMPACT_MASK only
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, MaskTexture)
+
+		// Output: Encoded distortion atlas (RGB10A2 UNORM), WRITE_DISTORTION only
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float4>, DistortionTexture)
 
 		// Volume resolution
 		SHADER_PARAMETER(FIntVector, Resolution)
 
-		// Blur direction: (1,0,0) for X, (0,1,0) for Y, (0,0,1) for Z
-		SHADER_PARAMETER(FIntVector, BlurDirection)
+		// Texel offset of the volume's hole atlas slot
+		SHADER_PARAMETER(FIntVector, SlotOffset)
+
+		// Distortion encoding range
+		SHADER_PARAMETER(float, DistortionRange)
 
-		// Blur radius in voxels
+		// Blur radius in voxels, FUSED_BLUR only
 		SHADER_PARAMETER(int32, BlurStep)
 	END_SHADER_PARAMETER_STRUCT()
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
+		// The RGBA16F atlas already holds distortion
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		if (!PermutationVector.Get<FCompactMaskDim>() && PermutationVector.Get<FWriteDistortionDim>())
+		{
+			return false;
+		}
 		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 
@@ -198,5 +356,6 @@ public:
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEX"), ThreadGroupSizeX);
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEY"), ThreadGroupSizeY);
 		OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEZ"), ThreadGroupSizeZ);
+		OutEnvironment.SetDefine(TEXT("MAX_BLUR_STEP"), MaxBlurStep);
 	}
 };
@@ -0,0 +1,85 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "IVSmokeHoleData.h"
+#include "IVSmokeHoleTrackerSubsystem.generated.h"
+
+class UIVSmokeHoleGeneratorComponent;
+
+/**
+ * @brief World-level tracker for dynamic hole subjects. Authority only.
+ *        Every tracked actor is polled once per tick and routed only to the hole generators containing it,
+ *        found through a uniform grid rebuilt over the registered generators each tick.
+ *        Holes are handed to each generator in one batch.
+ */
+UCLASS()
+class IVSMOKE_API UIVSmokeHoleTrackerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** World-space size of a broad-phase grid cell. */
+	static constexpr float CellSize = 1000.0f;
+
+	/** Find the tracker of World. */
+	static UIVSmokeHoleTrackerSubsystem* Get(const UWorld* World);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	//~============================================================================
+	// Public API
+#pragma region API
+public:
+	/** Add a generator to the broad phase. Called by the generator on BeginPlay. */
+	void RegisterGenerator(UIVSmokeHoleGeneratorComponent* Generator);
+
+	/** Remove a generator and every subject restricted to it. Called by the generator on EndPlay. */
+	void UnregisterGenerator(UIVSmokeHoleGeneratorComponent* Generator);
+
+	/**
+	 * Track an actor with a dynamic preset.
+	 * @param Generator		Restrict holes to this generator. Null tracks the actor through every smoke volume with one registration.
+	 * @return				False if the actor is already tracked for Generator or the preset is not dynamic.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "IVSmoke | Hole | API")
+	bool RegisterSubject(AActor* TargetActor, UIVSmokeHolePreset* Preset, UIVSmokeHoleGeneratorComponent* Generator = nullptr);
+
+	/** Stop tracking an actor for Generator, or for every volume when Generator is null. */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "IVSmoke | Hole | API")
+	void UnregisterSubject(AActor* TargetActor, UIVSmokeHoleGeneratorComponent* Generator = nullptr);
+
+	/** Stop tracking every subject restricted to Generator. */
+	void UnregisterSubjects(const UIVSmokeHoleGeneratorComponent* Generator);
+#pragma endregion
+
+private:
+	/** Tracked subjects. */
+	UPROPERTY(Transient)
+	TArray<FIVSmokeHoleDynamicSubject> Subjects;
+
+	/** Registered generators. */
+	TArray<TWeakObjectPtr<UIVSmokeHoleGeneratorComponent>> Generators;
+
+	/** Generator bounds, rebuilt each tick. Parallel to Generators. */
+	TArray<FBox3f> GeneratorBounds;
+
+	/** Cell -> Generators indices, rebuilt each tick. */
+	TMap<FIntVector, TArray<int32, TInlineAllocator<4>>> GeneratorCells;
+
+	/** Holes gathered this tick. Parallel to Generators. */
+	TArray<TArray<FIVSmokeHoleData>> PendingHoles;
+
+	/** Drop dead generators and rebuild the broad-phase grid. */
+	void RebuildGeneratorCells();
+
+	FORCEINLINE static FIntVector ToCell(const FVector3f& Position)
+	{
+		return FIntVector(
+			FMath::FloorToInt32(Position.X / CellSize),
+			FMath::FloorToInt32(Position.Y / CellSize),
+			FMath::FloorToInt32(Position.Z / CellSize));
+	}
+};
@@ -10,6 +10,7 @@
 #include "Shader.h"
 #include "ShaderCompilerCore.h"
 #include "ShaderParameterStruct.h"
+#include "IVSmokeVoxelAtlas.h"
 
 // Forward declarations
 struct FIVSmokeVolumeGPUData;
@@ -50,6 +51,35 @@ struct FIVSmokeOccupancyConfig
 	static constexpr uint32 OccupancyBuildThreadsZ = 4;
 };
 
+/**
+ * Light transmittance atlas configuration constants.
+ * Every rendered volume gets a Resolution^3 grid of transmittance toward the main light.
+ *
+ * Memory Layout (128 volumes):
+ *   Grids: 16 per row along X, rows stack along Y (slot = index in the volume data buffer)
+ *   Atlas: 512 × 256 × 32 texels, R16F
+ *   Total Memory: 8 MB
+ */
+struct FIVSmokeLightTransmittanceConfig
+{
+	/** Grid texels per axis. One thread group sweeps a whole slice, so Resolution^2 must fit a group. */
+	static constexpr uint32 Resolution = 32;
+
+	/** Grids per atlas row. */
+	static constexpr uint32 SlotsPerRow = 16;
+
+	/** Atlas resolution holding VolumeCount grids. */
+	static FIntVector GetAtlasResolution(const int32 VolumeCount)
+	{
+		const int32 Columns = FMath::Clamp(VolumeCount, 1, (int32)SlotsPerRow);
+		const int32 Rows = FMath::Max(1, FMath::DivideAndRoundUp(VolumeCount, (int32)SlotsPerRow));
+		return FIntVector(Columns, Rows, 1) * (int32)Resolution;
+	}
+};
+
+static_assert(FIVSmokeLightTransmittanceConfig::Resolution * FIVSmokeLightTransmittanceConfig::Resolution <= 1024,
+	"One light transmittance slice must fit a thread group");
+
 //~==============================================================================
 // GPU Data Structures
 
@@ -236,6 +266,46 @@ public:
 	}
 };
 
+//~==============================================================================
+// Density Sampling Parameters
+
+/**
+ * Inputs of the per-volume density evaluation in IVSmokeDensitySampling.ush.
+ * Shared by the ray march and the light transmittance build, which sample the same density.
+ */
+BEGIN_SHADER_PARAMETER_STRUCT(FIVSmokeDensitySamplingParameters, IVSMOKE_API)
+	// Noise
+	SHADER_PARAMETER_RDG_TEXTURE(Texture3D, NoiseVolume)
+	SHADER_PARAMETER(float, NoiseUVMul)
+	SHADER_PARAMETER(float, ElapsedTime)
+
+	// Samplers
+	SHADER_PARAMETER_SAMPLER(SamplerState, LinearBorder_Sampler)
+	SHADER_PARAMETER_SAMPLER(SamplerState, LinearRepeat_Sampler)
+
+	// Multi-Volume Data
+	SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FIVSmokeVolumeGPUData>, VolumeDataBuffer)
+
+	// Packed Voxel Data
+	SHADER_PARAMETER(int, PackedInterval)
+	SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, PackedVoxelAtlas)
+	SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, VoxelTimeAtlas)
+	SHADER_PARAMETER(float, GameTime)
+	SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, PackedHoleAtlas)
+	SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, PackedHoleDistortionAtlas)
+	SHADER_PARAMETER(FIntVector, PackedVoxelTexSize)
+	SHADER_PARAMETER(FIntVector, HoleTexSize)
+	SHADER_PARAMETER(FIntVector, PackedHoleTexSize)
+	SHADER_PARAMETER(FIntVector, HoleAtlasCount)
+
+	// Global Smoke Parameters
+	SHADER_PARAMETER(float, SmokeSize)
+	SHADER_PARAMETER(FVector3f, WindDirection)
+	SHADER_PARAMETER(float, VolumeRangeOffset)
+	SHADER_PARAMETER(float, VolumeEdgeNoiseFadeOffset)
+	SHADER_PARAMETER(float, VolumeEdgeFadeSharpness)
+END_SHADER_PARAMETER_STRUCT()
+
 //~==============================================================================
 // Pass 2: Ray March with Occupancy Compute Shader
 
@@ -262,6 +332,17 @@ public:
 	DECLARE_GLOBAL_SHADER(FIVSmokeMultiVolumeRayMarchCS);
 	SHADER_USE_PARAMETER_STRUCT(FIVSmokeMultiVolumeRayMarchCS, FGlobalShader);
 
+	/** Hole atlas holds an R8/R16 density mask instead of RGBA16F (distortion + mask). */
+	class FCompactHoleDim : SHADER_PERMUTATION_BOOL("HOLE_COMPACT");
+
+	/** Hole distortion is sampled. Always on for the RGBA16F atlas, compact atlas reads PackedHoleDistortionAtlas. */
+	class FHoleDistortionDim : SHADER_PERMUTATION_BOOL("HOLE_DISTORTION");
+
+	/** Voxels are read from the RG32F birth/death time atlas and faded per sample instead of the density atlas. */
+	class FVoxelTimeAtlasDim : SHADER_PERMUTATION_BOOL("VOXEL_TIME_ATLAS");
+
+	using FPermutationDomain = TShaderPermutationDomain<FCompactHoleDim, FHoleDistortionDim, FVoxelTimeAtlasDim>;
+
 	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
 		// Output (Dual Render Target)
 		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, SmokeAlbedoTex)
@@ -278,16 +359,8 @@ public:
 		SHADER_PARAMETER(uint32, StepSliceCount)
 		SHADER_PARAMETER(uint32, StepDivisor)
 
-		// Input Textures (same as original ray march)
-		SHADER_PARAMETER_RDG_TEXTURE(Texture3D, NoiseVolume)
-		SHADER_PARAMETER(float, NoiseUVMul)
-
-		// Samplers
-		SHADER_PARAMETER_SAMPLER(SamplerState, LinearBorder_Sampler)
-		SHADER_PARAMETER_SAMPLER(SamplerState, LinearRepeat_Sampler)
-
-		// Time
-		SHADER_PARAMETER(float, ElapsedTime)
+		// Density sampling (noise, voxel and hole atlases)
+		SHADER_PARAMETER_STRUCT_INCLUDE(FIVSmokeDensitySamplingParameters, Density)
 
 		// Viewport
 		SHADER_PARAMETER(FIntPoint, TexSize)
@@ -307,19 +380,11 @@ public:
 		SHADER_PARAMETER(float, MinStepSize)
 
 		// Multi-Volume Data
-		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FIVSmokeVolumeGPUData>, VolumeDataBuffer)
 		SHADER_PARAMETER(uint32, NumActiveVolumes)
 
-		// Packed Voxel Data
-		SHADER_PARAMETER(int, PackedInterval)
-		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, PackedVoxelAtlas)
-		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, PackedHoleAtlas)
-		SHADER_PARAMETER(FIntVector, VoxelTexSize)
-		SHADER_PARAMETER(FIntVector, PackedVoxelTexSize)
-		SHADER_PARAMETER(FIntVector, VoxelAtlasCount)
-		SHADER_PARAMETER(FIntVector, HoleTexSize)
-		SHADER_PARAMETER(FIntVector, PackedHoleTexSize)
-		SHADER_PARAMETER(FIntVector, HoleAtlasCount)
+		// Empty space skipping inside volumes: max density (or birth/death times) per macro cell
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, VoxelMacroCellAtlas)
+		SHADER_PARAMETER(int32, bUseMacroCells)
 
 		// Scene Textures
 		SHADER_PARAMETER_RDG_UNIFORM_BUFFER(FSceneTextureUniformParameters, SceneTexturesStruct)
@@ -336,11 +401,6 @@ public:
 
 		// Global Smoke Parameters
 		SHADER_PARAMETER(float, GlobalAbsorption)
-		SHADER_PARAMETER(float, SmokeSize)
-		SHADER_PARAMETER(FVector3f, WindDirection)
-		SHADER_PARAMETER(float, VolumeRangeOffset)
-		SHADER_PARAMETER(float, VolumeEdgeNoiseFadeOffset)
-		SHADER_PARAMETER(float, VolumeEdgeFadeSharpness)
 
 		// Rayleigh Scattering
 		SHADER_PARAMETER(FVector3f, LightDirection)
@@ -354,6 +414,11 @@ public:
 		SHADER_PARAMETER(float, LightMarchingExpFactor)
 		SHADER_PARAMETER(float, ShadowAmbient)
 
+		// Self-Shadowing (Light Transmittance Atlas, replaces light marching when set)
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D, LightTransmittanceAtlas)
+		SHADER_PARAMETER(FVector3f, LightTransmittanceAtlasInvSize)
+		SHADER_PARAMETER(int32, bUseLightTransmittance)
+
 		// Global AABB for light march distance calculation (per-pixel ray-box intersection)
 		SHADER_PARAMETER(FVector3f, GlobalAABBMin)
 		SHADER_PARAMETER(FVector3f, GlobalAABBMax)
@@ -386,6 +451,12 @@ public:
 
 	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
 	{
+		// The RGBA16F atlas always carries distortion
+		const FPermutationDomain PermutationVector(Parameters.PermutationId);
+		if (!PermutationVector.Get<FCompactHoleDim>() && !PermutationVector.Get<FHoleDistortionDim>())
+		{
+			return false;
+		}
 		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
 	}
 
@@ -398,6 +469,60 @@ public:
 		OutEnvironment.SetDefine(TEXT("TILE_SIZE_Y"), FIVSmokeOccupancyConfig::TileSizeY);
 		OutEnvironment.SetDefine(TEXT("MAX_VOLUMES"), FIVSmokeOccupancyConfig::MaxVolumes);
 		OutEnvironment.SetDefine(TEXT("USE_OCCUPANCY"), 1);
+		OutEnvironment.SetDefine(TEXT("MACRO_CELL_SIZE"), FIVSmokeVoxelAtlas::MacroCellSize);
+		OutEnvironment.SetDefine(TEXT("LIGHT_TRANSMITTANCE_RESOLUTION"), FIVSmokeLightTransmittanceConfig::Resolution);
+		OutEnvironment.SetDefine(TEXT("LIGHT_TRANSMITTANCE_SLOTS_PER_ROW"), FIVSmokeLightTransmittanceConfig::SlotsPerRow);
+	}
+};
+
+//~==============================================================================
+// Light Transmittance Build Compute Shader
+
+/**
+ * Light transmittance build compute shader.
+ * Sweeps each volume's grid slice by slice along the light's dominant axis, so the ray march
+ * reads self-shadowing with one fetch instead of marching toward the light per sample.
+ *
+ * Dispatch: (1, 1, VolumeCount)
+ * Each thread group sweeps one volume (Resolution × Resolution threads, one per texel of a slice).
+ */
+class IVSMOKE_API FIVSmokeLightTransmittanceCS : public FGlobalShader
+{
+public:
+	static constexpr uint32 ThreadGroupSizeX = FIVSmokeLightTransmittanceConfig::Resolution;
+	static constexpr uint32 ThreadGroupSizeY = FIVSmokeLightTransmittanceConfig::Resolution;
+	static constexpr uint32 ThreadGroupSizeZ = 1;
+	static constexpr const TCHAR* EventName = TEXT("IVSmokeLightTransmittanceCS");
+
+	DECLARE_GLOBAL_SHADER(FIVSmokeLightTransmittanceCS);
+	SHADER_USE_PARAMETER_STRUCT(FIVSmokeLightTransmittanceCS, FGlobalShader);
+
+	/** Samples the same density as the ray march, so it shares its permutations. */
+	using FPermutationDomain = FIVSmokeMultiVolumeRayMarchCS::FPermutationDomain;
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		// Output: one grid per volume
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, LightTransmittanceAtlasRW)
+
+		// Density sampling (noise, voxel and hole atlases)
+		SHADER_PARAMETER_STRUCT_INCLUDE(FIVSmokeDensitySamplingParameters, Density)
+		SHADER_PARAMETER(uint32, NumActiveVolumes)
+		SHADER_PARAMETER(float, GlobalAbsorption)
+
+		// Light
+		SHADER_PARAMETER(FVector3f, LightDirection)
+	END_SHADER_PARAMETER_STRUCT()
+
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return FIVSmokeMultiVolumeRayMarchCS::ShouldCompilePermutation(Parameters);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("LIGHT_TRANSMITTANCE_RESOLUTION"), FIVSmokeLightTransmittanceConfig::Resolution);
+		OutEnvironment.SetDefine(TEXT("LIGHT_TRANSMITTANCE_SLOTS_PER_ROW"), FIVSmokeLightTransmittanceConfig::SlotsPerRow);
 	}
 };
 
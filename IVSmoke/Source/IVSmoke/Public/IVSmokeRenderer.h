@@ -9,16 +9,21 @@
 #include "SceneView.h"
 #include "IVSmokeSettings.h"
 #include "IVSmokeVisualMaterialPreset.h"
+#include "UObject/ObjectKey.h"
 
 class AIVSmokeVoxelVolume;
 class FRDGBuilder;
 class FSceneView;
 class UIVSmokeSmokePreset;
+class UIVSmokeHoleGeneratorComponent;
 class UTextureRenderTargetVolume;
+class UDirectionalLightComponent;
+class ULevel;
 struct FPostProcessMaterialInputs;
 class FIVSmokeCSMRenderer;
 class FIVSmokeVSMProcessor;
 struct FIVSmokeOccupancyResources;
+struct FIVSmokeVoxelAtlasRegion;
 
 //~==============================================================================
 // Internal Noise Generation Constants
@@ -48,25 +53,15 @@ struct FIVSmokeNoiseConfig
  * Packed render data for all smoke volumes.
  * Created on Game Thread, consumed on Render Thread.
  * Contains all data needed for rendering without accessing Volume actors.
+ * Handed to the Render Thread as an immutable FIVSmokeRenderDataSnapshot shared by every view of the frame.
  */
 struct IVSMOKE_API FIVSmokePackedRenderData
 {
-	/** Packed voxel birth times for all volumes (flattened by VoxelBufferOffset). */
-	TArray<float> PackedVoxelBirthTimes;
-
-	/** Packed voxel death times for all volumes (flattened by VoxelBufferOffset). */
-	TArray<float> PackedVoxelDeathTimes;
-
-	/** Per-volume GPU metadata */
+	/** Per-volume GPU metadata. Voxel data lives in the persistent FIVSmokeVoxelAtlas, see FIVSmokeVolumeGPUData::VoxelAtlasOffset */
 	TArray<FIVSmokeVolumeGPUData> VolumeDataArray;
 
-	/** Hole Texture references (RHI resources are thread-safe) */
-	TArray<FTextureRHIRef> HoleTextures;
-	TArray<FIntVector> HoleTextureSizes;
-
-	/** Common resolution info */
+	/** Largest grid resolution among the volumes (density pass dispatch size, holes live in the persistent FIVSmokeHoleAtlas) */
 	FIntVector VoxelResolution = FIntVector::ZeroValue;
-	FIntVector HoleResolution = FIntVector::ZeroValue;
 	int32 VolumeCount = 0;
 
 	/** Preset parameters (copied from default preset) */
@@ -94,6 +89,10 @@ struct IVSMOKE_API FIVSmokePackedRenderData
 	float LightMarchingDistance = 0.0f;
 	float LightMarchingExpFactor = 2.0f;
 	float ShadowAmbient = 0.2f;
+	bool bUseLightTransmittanceVolume = false;
+
+	/** Changes with the density the light transmittance grids are built from: voxel uploads, hole edits and fade/hole animation steps. */
+	uint32 LightTransmittanceDensityKey = 0;
 
 	/** External shadowing parameters (CSM - Cascaded Shadow Maps) */
 	/** Note: CSM is always used when external shadowing is enabled */
@@ -116,6 +115,14 @@ struct IVSMOKE_API FIVSmokePackedRenderData
 	/** Main camera position for CSM (must match what CSMRenderer used) */
 	FVector CSMMainCameraPosition = FVector::ZeroVector;
 
+	/** Temporal accumulation parameters */
+	bool bEnableTemporalAccumulation = false;
+	float TemporalStepReduction = 2.0f;
+	float TemporalHistoryWeight = 0.9f;
+
+	/** World bounds of the volumes whose voxel data was uploaded this frame. Temporal history is scaled down inside them. */
+	TArray<FBox3f> ChangedVolumeBounds;
+
 	/** Validity flag */
 	bool bIsValid = false;
 
@@ -128,11 +135,7 @@ struct IVSMOKE_API FIVSmokePackedRenderData
 	/** Reset to invalid state */
 	void Reset()
 	{
-		PackedVoxelBirthTimes.Empty();
-		PackedVoxelDeathTimes.Empty();
 		VolumeDataArray.Empty();
-		HoleTextures.Empty();
-		HoleTextureSizes.Empty();
 		VolumeCount = 0;
 		bIsValid = false;
 
@@ -145,10 +148,14 @@ struct IVSMOKE_API FIVSmokePackedRenderData
 		CSMLightCameraPositions.Empty();
 		CSMLightCameraForwards.Empty();
 
+		ChangedVolumeBounds.Empty();
 		SmokeVisualMaterial = nullptr;
 	}
 };
 
+/** Immutable render data shared between the Game Thread and every view rendered from it. */
+using FIVSmokeRenderDataSnapshot = TSharedPtr<const FIVSmokePackedRenderData, ESPMode::ThreadSafe>;
+
 /**
  * Manages registered smoke volumes and handles rendering.
  * Owns shared rendering resources (noise volume) and reads settings from UIVSmokeSettings.
@@ -173,37 +180,55 @@ public:
 	/** Check if server time offset was set. */
 	bool bIsServerTimeSynced() const { return bServerTimeSynced; }
 
+	/** Whether a CSM capture is in progress. View families rendered by it must not prepare render data. */
+	bool IsCapturingShadow() const { return bIsCapturingShadow; }
+
 	/** SetServerTimeOffset for smoke wind animation. */
 	void SetServerTimeOffset(const float InServerTimeOffset) { bServerTimeSynced = true;  ServerTimeOffset = InServerTimeOffset; }
 
+	/** Number of TexSize textures packed per axis to fit TexCount textures in a TexturePackMaxSize atlas. */
+	static FIntVector GetAtlasTexCount(const FIntVector& TexSize, const int32 TexCount, const int32 TexturePackInterval, const int32 TexturePackMaxSize);
+
 	//~==============================================================================
 	// Thread-Safe Render Data (Game Thread Render Thread)
 
 	/** Maximum number of volumes supported for rendering. */
 	static constexpr int32 MaxSupportedVolumes = 128;
 
+	/** Frames a volume keeps its voxel atlas slot after it was last rendered, so view families with different culling do not thrash slots. */
+	static constexpr uint32 VoxelAtlasSlotGraceFrames = 60;
+
 	/**
 	 * Prepare render data from all registered volumes.
 	 * Must be called on Game Thread.
 	 * Copies and packs all volume data for safe Render Thread access.
-	 * If volume count exceeds MaxSupportedVolumes (128), filters by distance from camera.
+	 * Volumes are ranked by significance (projected screen area and opacity). If volume count exceeds
+	 * MaxSupportedVolumes (128), the least significant are dropped, and step quality is budgeted by significance.
 	 *
 	 * @param InVolumes Array of volumes to process
-	 * @param CameraPosition Camera world position for distance-based filtering
+	 * @param CameraPosition Camera world position of the primary view
+	 * @param ProjectionMatrix Projection matrix of the primary view, for screen coverage
 	 * @return Packed render data ready for Render Thread
 	 */
-	FIVSmokePackedRenderData PrepareRenderData(const TArray<AIVSmokeVoxelVolume*>& InVolumes, const FVector& CameraPosition);
+	FIVSmokePackedRenderData PrepareRenderData(const TArray<AIVSmokeVoxelVolume*>& InVolumes, const FVector& CameraPosition, const FMatrix& ProjectionMatrix);
 
 	/**
-	 * Set cached render data for next frame.
+	 * Set cached render data for next frame. nullptr stops rendering.
 	 * Called from Render Thread via ENQUEUE_RENDER_COMMAND.
 	 */
-	void SetCachedRenderData(FIVSmokePackedRenderData&& InRenderData)
+	void SetCachedRenderData(FIVSmokeRenderDataSnapshot InRenderData)
 	{
 		FScopeLock Lock(&RenderDataMutex);
 		CachedRenderData = MoveTemp(InRenderData);
 	}
 
+	/** Get the current render data snapshot. Only the reference is copied, the data itself is never modified. */
+	FIVSmokeRenderDataSnapshot GetCachedRenderData() const
+	{
+		FScopeLock Lock(&RenderDataMutex);
+		return CachedRenderData;
+	}
+
 	//~==============================================================================
 	// Rendering
 
@@ -247,7 +272,6 @@ private:
 	FIVSmokeRenderer();   // Defined in cpp for TUniquePtr with forward-declared types
 	~FIVSmokeRenderer();
 
-	FIntVector GetAtlasTexCount(const FIntVector& TexSize, const int32 TexCount, const int32 TexturePackInterval, const int32 TexturePackMaxSize) const;
 	//~==============================================================================
 	// Resource Management
 
@@ -257,6 +281,25 @@ private:
 	/** Get the effective preset for a volume (override or default). */
 	const UIVSmokeSmokePreset* GetEffectivePreset(const AIVSmokeVoxelVolume* Volume) const;
 
+	/**
+	 * Build the GPU metadata of one volume. Only reads the volume, so PrepareRenderData runs it in parallel.
+	 * @return Data with VoxelAtlasSlot == INDEX_NONE when the volume is null or has no voxel atlas slot.
+	 */
+	FIVSmokeVolumeGPUData BuildVolumeGPUData(const AIVSmokeVoxelVolume* Volume, const UIVSmokeHoleGeneratorComponent* HoleComp, const int32 VoxelAtlasSlot, const FIVSmokeVoxelAtlasRegion& VoxelAtlasRegion) const;
+
+	/**
+	 * Estimate how much a volume contributes to the image: fraction of the screen its active smoke covers
+	 * times a cheap opacity estimate (active voxel fill of its bounds and preset density).
+	 * @param OutScreenCoverage Projected area of the smoke bounds as a fraction of the screen, clamped to 1.
+	 */
+	float ComputeVolumeSignificance(const AIVSmokeVoxelVolume* Volume, const FVector& CameraPosition, const FMatrix& ProjectionMatrix, float& OutScreenCoverage) const;
+
+	/** Get the voxel atlas slot of a rendered volume, allocating it on first use, and mark it used this frame. Must be called on Game Thread. */
+	int32 FindOrAllocateVoxelAtlasSlot(const AIVSmokeVoxelVolume* Volume);
+
+	/** Free the voxel atlas slots of destroyed volumes and of volumes not rendered for VoxelAtlasSlotGraceFrames. */
+	void FreeUnusedVoxelAtlasSlots();
+
 	//~==============================================================================
 	// Pass Functions
 
@@ -298,6 +341,21 @@ private:
 		FRDGTextureRef SceneDepthForDependency = nullptr
 	);
 
+	/**
+	 * Temporal accumulation of the half resolution ray march outputs.
+	 * Reprojects this view's last accumulated frame, clamps it to the current 3x3 neighborhood and blends it in.
+	 * The accumulated textures replace InOutSmokeAlbedo and InOutSmokeLocalPosAlpha and become the next frame's history.
+	 */
+	void AddTemporalAccumulatePass(
+		FRDGBuilder& GraphBuilder,
+		const FSceneView& View,
+		const FIVSmokePackedRenderData& RenderData,
+		FRDGTextureRef& InOutSmokeAlbedo,
+		FRDGTextureRef& InOutSmokeLocalPosAlpha,
+		FRDGTextureRef SmokeWorldPosDepth,
+		const FIntPoint& TexSize
+	);
+
 	/**
 	 * Copy/Resize Pass using bilinear sampling.
 	 * Used for upscaling (1/2 resolution to Full) to improve quality.
@@ -344,6 +402,7 @@ private:
 	 * @param SmokeLocalPosAlpha	Smoke (local position, alpha) texture from ray marching
 	 * @param TexSize				Output texture size
 	 * @param ViewRectMin			ViewRect offset for UV calculation
+	 * @param UpsampleRatio			Output size over ray march size, the filter footprint covers one ray march texel
 	 */
 	FRDGTextureRef AddUpsampleFilterPass(
 		FRDGBuilder& GraphBuilder,
@@ -353,7 +412,8 @@ private:
 		FRDGTextureRef SmokeAlbedo,
 		FRDGTextureRef SmokeLocalPosAlpha,
 		const FIntPoint& TexSize,
-		const FIntPoint& ViewRectMin
+		const FIntPoint& ViewRectMin,
+		const FVector2f& UpsampleRatio
 	);
 
 	/**
@@ -445,6 +505,117 @@ private:
 	/** View → Cache map (valid only within same frame's RDG builder). */
 	TMap<const FSceneViewStateInterface*, FViewRDGCache> FrameViewCaches;
 
+	/**
+	 * Accumulated ray march outputs of one view, kept across frames.
+	 * Heap allocated so extraction targets stay put while the map grows within a frame. Render Thread only.
+	 */
+	struct FTemporalHistory
+	{
+		TRefCountPtr<IPooledRenderTarget> Albedo;
+		TRefCountPtr<IPooledRenderTarget> LocalPosAlpha;
+		FMatrix PrevTranslatedWorldToClip = FMatrix::Identity;
+		FVector PrevViewOrigin = FVector::ZeroVector;
+		uint32 LastFrameNumber = 0;
+	};
+
+	/**
+	 * History weight multiplier inside volumes whose voxel data was uploaded this frame.
+	 * Expanding or dissipating smoke would otherwise trail behind its voxels, 0.5 halves the lag at the cost of some noise.
+	 */
+	static constexpr float ChangedVolumeHistoryScale = 0.5f;
+
+	/** View → temporal history. Entries of views that stopped rendering are dropped after a while. */
+	TMap<const FSceneViewStateInterface*, TUniquePtr<FTemporalHistory>> TemporalHistories;
+
+	//~==============================================================================
+	// Dynamic Resolution (Render Thread only)
+
+	/** Ray march resolution scale step. The scale only moves in whole steps, so pooled textures are not re-created every frame. */
+	static constexpr float RayMarchResolutionScaleStep = 0.0625f;
+
+	/** Ray march texture size of a viewport at Scale per axis. */
+	static FIntPoint ComputeRayMarchSize(const FIntPoint& ViewportSize, float Scale);
+
+	/**
+	 * Read back the view's finished pre-pass timings and move its ray march resolution scale towards the GPU time budget.
+	 * Returns the fixed half resolution scale when dynamic resolution is disabled.
+	 */
+	float UpdateRayMarchResolutionScale(const UIVSmokeSettings& Settings, const FSceneView& View);
+
+	/** GPU timestamps of one pre-pass. Scaled brackets the passes at ray march resolution (ray march, temporal accumulation). */
+	enum class EPrePassTimestamp : uint8
+	{
+		Begin,
+		ScaledBegin,
+		ScaledEnd,
+		End,
+		Num
+	};
+
+	/** Write GPU timestamps around the view's pre-pass. The set is queued for a non-blocking readback a few frames later. */
+	void BeginPrePassTiming(FRDGBuilder& GraphBuilder, const FSceneView& View, float Scale);
+	void EndPrePassTiming(FRDGBuilder& GraphBuilder, const FSceneView& View);
+
+	/** Write one timestamp of the pre-pass being timed. Does nothing outside Begin/EndPrePassTiming. */
+	void AddPrePassTimestamp(FRDGBuilder& GraphBuilder, const FSceneView& View, EPrePassTimestamp Timestamp);
+
+	/** Timestamps of one pre-pass, read back once all are available. */
+	struct FPrePassTiming
+	{
+		FRHIPooledRenderQuery Timestamps[(int32)EPrePassTimestamp::Num];
+		float Scale = 0.0f;
+	};
+
+	/** True between Begin/EndPrePassTiming. */
+	bool bTimingPrePass = false;
+
+	/** Dynamic resolution state of one view. Every view is measured against the budget on its own. */
+	struct FDynamicResolutionState
+	{
+		/** Timings in submission order. */
+		TArray<FPrePassTiming> PendingTimings;
+
+		/** Current ray march resolution scale per axis. */
+		float Scale = 0.5f;
+
+		/** Smoothed GPU milliseconds of the scaled passes per unit of scale squared (full resolution ray march area). */
+		double SmoothedCostMs = 0.0;
+
+		/** Smoothed GPU milliseconds of the remaining pre-pass (per-volume passes, full resolution upsample and depth write). */
+		double SmoothedFixedMs = 0.0;
+
+		uint32 LastFrameNumber = 0;
+	};
+
+	FRenderQueryPoolRHIRef TimestampQueryPool;
+
+	/** View → dynamic resolution state. Entries of views that stopped rendering are dropped after a while. */
+	TMap<const FSceneViewStateInterface*, FDynamicResolutionState> DynamicResolutionStates;
+
+	/** Ray march resolution scale of the last rendered view, for stats and memory estimates. */
+	float RayMarchResolutionScale = 0.5f;
+
+	/** Last measured pre-pass GPU time for stats. */
+	float LastPrePassGPUTimeMs = 0.0f;
+
+	//~==============================================================================
+	// Light Transmittance (Render Thread only)
+
+	/** Light transmittance grids of the last rebuild, reused by every view until their inputs change. */
+	TRefCountPtr<IPooledRenderTarget> LightTransmittanceAtlasRT;
+
+	/** Hash of the inputs the kept grids were built from. */
+	uint32 LightTransmittanceInputHash = 0;
+
+	/** Light direction the kept grids were built with. */
+	FVector3f LightTransmittanceLightDirection = FVector3f::ZeroVector;
+
+	/** Cosine of the light direction change that rebuilds the grids (1 degree). Slower sun motion is caught up in steps. */
+	static constexpr float LightTransmittanceLightCosThreshold = 0.99985f;
+
+	/** Hash of everything the light transmittance grids depend on besides the light direction. View dependent fields are ignored. */
+	static uint32 ComputeLightTransmittanceInputHash(const FIVSmokePackedRenderData& RenderData, bool bVoxelTimeAtlas);
+
 public:
 	/** Clear frame view caches. Called at end of frame from SceneViewExtension. */
 	void ClearFrameViewCaches() { FrameViewCaches.Empty(); }
@@ -463,6 +634,15 @@ private:
 	/** ServerTime offset for animation. (ServerTime = LocalTime + Offset) */
 	float ServerTimeOffset = 0.0f;
 
+	//~==============================================================================
+	// Light Transmittance (Game Thread only)
+
+	/** Bumped whenever voxel data is uploaded, keys the light transmittance rebuild. */
+	uint32 VoxelUploadGeneration = 0;
+
+	/** Fades and hole animations are time driven, their grids are refreshed at this interval instead of every frame. */
+	static constexpr float LightTransmittanceAnimationInterval = 0.1f;
+
 	//~==============================================================================
 	// External Shadowing (CSM - Cascaded Shadow Maps)
 
@@ -491,8 +671,8 @@ private:
 	void CleanupCSM();
 
 	/**
-	 * Find the main directional light (Atmosphere Sun Light) in the world.
-	 * Uses the same logic as the engine: bAtmosphereSunLight + AtmosphereSunLightIndex.
+	 * Get the main directional light (Atmosphere Sun Light) of the world.
+	 * The light is searched once per world and cached, direction, color and intensity are read from the cached component.
 	 *
 	 * @param World          World to search in
 	 * @param OutDirection   Direction TOWARD the light source (opposite of light travel direction)
@@ -502,11 +682,79 @@ private:
 	 */
 	bool GetMainDirectionalLight(UWorld* World, FVector& OutDirection, FLinearColor& OutColor, float& OutIntensity);
 
+	/**
+	 * Search the world for the main directional light.
+	 * Uses the same logic as the engine: bAtmosphereSunLight + AtmosphereSunLightIndex, else the first directional light.
+	 */
+	UDirectionalLightComponent* FindMainDirectionalLight(UWorld* World) const;
+
+	/** Cached main light of one world and the actor events that invalidate it. */
+	struct FMainLightCache
+	{
+		/** Searched again when bDirty is set or the component is gone. */
+		TWeakObjectPtr<UDirectionalLightComponent> Light;
+
+		/** Set by the invalidation events, cleared by the next search. */
+		bool bDirty = true;
+
+		FDelegateHandle ActorSpawnedHandle;
+		FDelegateHandle ActorDestroyedHandle;
+	};
+
+	/** Find the cache of World, or add one and bind its invalidation events. Caches of destroyed worlds are dropped. */
+	FMainLightCache& FindOrAddMainLightCache(UWorld* World);
+
+	/** Unbind the main light events and drop every cached light. */
+	void ResetMainLightCache();
+
+	/** Invalidate the cached main light of World. */
+	void MarkMainLightDirty(const UWorld* World);
+
+	/** Invalidate the cached main light when a directional light is spawned or destroyed. */
+	void OnMainLightActorChanged(AActor* Actor);
+
+	/** Invalidate the cached main light when a level is streamed in or out of a cached world. */
+	void OnMainLightLevelChanged(ULevel* Level, UWorld* World);
+
+#if WITH_EDITOR
+	/** Invalidate the cached main light when a directional light property is edited (atmosphere sun flag or index). */
+	void OnMainLightPropertyChanged(UObject* Object, struct FPropertyChangedEvent& Event);
+#endif
+
+	/**
+	 * World → cached main light. Editor viewports and PIE render different worlds in the same session,
+	 * each keeps its own entry instead of re-searching on every switch.
+	 */
+	TMap<TWeakObjectPtr<UWorld>, FMainLightCache> MainLightCaches;
+
+	/** Level and property events are global, bound once while any world is cached. */
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+#if WITH_EDITOR
+	FDelegateHandle LightPropertyChangedHandle;
+#endif
+
+	//~==============================================================================
+	// Persistent Voxel Atlas
+
+	/** Voxel atlas slot of a volume and the last frame it was rendered. */
+	struct FVoxelAtlasSlotEntry
+	{
+		int32 Slot = INDEX_NONE;
+		uint32 LastUsedFrame = 0;
+	};
+
+	/** Voxel atlas slot of every recently rendered volume. Game Thread only. */
+	TMap<TObjectKey<AIVSmokeVoxelVolume>, FVoxelAtlasSlotEntry> VoxelAtlasSlots;
+
+	/** Volumes whose slot allocation failed and was already warned about. Game Thread only. */
+	TSet<TObjectKey<AIVSmokeVoxelVolume>> VoxelAtlasFailedVolumes;
+
 	//~==============================================================================
 	// Thread-Safe Render Data Cache
 
 	/** Cached render data prepared on Game Thread, consumed on Render Thread. */
-	FIVSmokePackedRenderData CachedRenderData;
+	FIVSmokeRenderDataSnapshot CachedRenderData;
 
 	/** Mutex for thread-safe access to CachedRenderData. */
 	mutable FCriticalSection RenderDataMutex;
@@ -521,6 +769,8 @@ private:
 	int64 CachedNoiseVolumeSize = 0;
 	int64 CachedCSMSize = 0;
 	int64 CachedPerFrameSize = 0;
+	int64 CachedHoleAtlasSize = 0;
+	int64 CachedVoxelAtlasSize = 0;
 
 	/** Update stats if 1 second has passed since last update. */
 	void UpdateStatsIfNeeded(const FIVSmokePackedRenderData& RenderData, const FIntPoint& ViewportSize);
@@ -529,8 +779,7 @@ private:
 	int64 CalculatePerFrameTextureSize(
 		const FIntPoint& ViewportSize,
 		int32 VolumeCount,
-		const FIntVector& VoxelResolution,
-		const FIntVector& HoleResolution
+		const FIntVector& VoxelResolution
 	) const;
 
 	/** Update all stat values. */
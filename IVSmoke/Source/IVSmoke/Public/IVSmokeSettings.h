@@ -92,6 +92,38 @@ enum class EIVSmokeExternalShadowQuality : uint8
 	Custom UMETA(DisplayName = "Custom")
 };
 
+/**
+ * Storage format of the per-volume hole textures and the packed hole atlas.
+ */
+UENUM(BlueprintType)
+enum class EIVSmokeHoleTextureFormat : uint8
+{
+	/** RGBA16F: density mask and distortion in one texture (8 bytes per voxel). */
+	Full UMETA(DisplayName = "Full (RGBA16F)"),
+
+	/** R16 density mask (2 bytes per voxel) plus RGB10A2 distortion only while explosions are active. */
+	CompactR16 UMETA(DisplayName = "Compact (R16 Mask)"),
+
+	/** R8 density mask (1 byte per voxel) plus RGB10A2 distortion only while explosions are active. */
+	CompactR8 UMETA(DisplayName = "Compact (R8 Mask)")
+};
+
+/**
+ * How voxel birth/death times reach the ray march.
+ */
+UENUM(BlueprintType)
+enum class EIVSmokeVoxelDataMode : uint8
+{
+	/** Times are evaluated into a density atlas and FXAA filtered by two compute passes every frame. */
+	DensityAtlas UMETA(DisplayName = "Density Atlas (Compute + FXAA)"),
+
+	/**
+	 * Times are written into a persistent RG32F atlas with texture region updates and the fade is evaluated per ray march sample.
+	 * No per-frame atlas passes. The atlas holds times rather than density, so the voxel FXAA cannot run on it and voxel edges look blockier.
+	 */
+	TimeAtlas UMETA(DisplayName = "Time Atlas (Direct Upload)")
+};
+
 class UIVSmokeVisualMaterialPreset;
 /**
  * Global settings for IVSmoke plugin.
@@ -198,6 +230,28 @@ public:
 			EditConditionHides))
 	float CustomShadowMaxDistance = 50000.0f;
 
+	/**
+	 * Ray march budget in screens of full-quality marching. Every volume marches at full quality while their total
+	 * screen coverage stays within this budget. Past it, volumes ranked low by projected screen area and opacity
+	 * lose step quality first, then all volumes are scaled down together.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Quality",
+		meta = (ClampMin = "0.25", ClampMax = "8.0", EditCondition = "bShowAdvancedOptions", EditConditionHides))
+	float VolumeStepBudget = 2.0f;
+
+	/** Lowest step quality a volume can be scaled down to. 0.25 = a quarter of the samples per unit length. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Quality",
+		meta = (ClampMin = "0.05", ClampMax = "1.0", EditCondition = "bShowAdvancedOptions", EditConditionHides))
+	float MinVolumeStepQuality = 0.25f;
+
+	/**
+	 * Leap over empty 4x4x4 voxel blocks inside a volume's bounds instead of stepping through them.
+	 * Inactive while VolumeEdgeNoiseFadeOffset is negative, since edge noise then reaches into empty voxels.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Quality",
+		meta = (EditCondition = "bShowAdvancedOptions", EditConditionHides))
+	bool bEnableMacroCellSkipping = true;
+
 	//~==============================================================================
 	// Quality Getters
 
@@ -304,6 +358,17 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | Self", meta = (ClampMin = "1.0", ClampMax = "5.0", EditCondition = "bShowAdvancedOptions", EditConditionHides))
 	float LightMarchingExpFactor = 2.0f;
 
+	/**
+	 * Precompute each volume's transmittance toward the light on a 32^3 grid, and read self-shadowing from it with one
+	 * fetch per sample instead of marching toward the light. The grid is rebuilt only when voxels or holes change, while
+	 * fades and holes animate (10 times a second) and when the light turns by more than a degree. Wind does not rebuild it,
+	 * the grid is built from the unscrolled noise.
+	 * Off by default: a 32^3 grid is coarser than light marching for large volumes, so enable it when self-shadowing
+	 * cost matters more than shadow detail. LightMarchingDistance and LightMarchingExpFactor only apply to light marching.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | Self", meta = (EditCondition = "bShowAdvancedOptions", EditConditionHides))
+	bool bUseLightTransmittanceVolume = false;
+
 	//~==============================================================================
 	// External Shadows (Scene Capture)
 
@@ -343,19 +408,37 @@ public:
 	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (ClampMin = "0.0", ClampMax = "0.5", EditCondition = "bShowAdvancedOptions && bEnableVSM", EditConditionHides))
 	float VSMLightBleedingReduction = 0.2f;
 
-	// TODO: Priority Update system disabled - causes shadow flickering due to texel snapping
-	// synchronization issues. Properties kept for serialization compatibility.
-	// See IVSmokeCSMRenderer::UpdateCascadePriorities for details.
-
-	UPROPERTY()
+	/**
+	 * Re-capture cascades on staggered intervals instead of every frame.
+	 * Stale cascades keep sampling with the matrices they were captured with, so far cascades can lag moving
+	 * shadow casters by up to FarCascadeUpdateInterval frames. Off by default: every cascade is captured every frame.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (EditCondition = "bShowAdvancedOptions", EditConditionHides))
 	bool bEnablePriorityUpdate = false;
 
-	UPROPERTY()
+	/** Capture interval of the nearest cascade in frames. Cascades in between are interpolated. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "bShowAdvancedOptions && bEnablePriorityUpdate", EditConditionHides))
 	int32 NearCascadeUpdateInterval = 1;
 
-	UPROPERTY()
+	/** Capture interval of the farthest cascade in frames. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (ClampMin = "1", ClampMax = "16", EditCondition = "bShowAdvancedOptions && bEnablePriorityUpdate", EditConditionHides))
 	int32 FarCascadeUpdateInterval = 4;
 
+	/**
+	 * Extra ortho width around each cascade's split distance while priority update is on (fraction of the split distance).
+	 * A stale cascade is re-captured early once the camera moves farther than this from where it was captured.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (ClampMin = "0.0", ClampMax = "0.5", EditCondition = "bShowAdvancedOptions && bEnablePriorityUpdate", EditConditionHides))
+	float CascadeCoveragePadding = 0.1f;
+
+	/**
+	 * Fit each cascade to the smoke volumes within its split range instead of the whole range around the camera.
+	 * Shadows are only sampled inside smoke, so the shadow map texels go to the smoke. Cascades without smoke are not captured.
+	 * Fitted widths are power of two multiples of the nearest cascade's width, which keeps every cascade on the shared texel grid.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Shadows | External", meta = (EditCondition = "bShowAdvancedOptions", EditConditionHides))
+	bool bFitCascadesToSmoke = false;
+
 	//~==============================================================================
 	// Post Processing (Voxel FXAA)
 
@@ -389,6 +472,68 @@ public:
 		meta = (ClampMin = "0.0", ClampMax = "100.0", EditCondition = "bShowAdvancedOptions && bEnableDepthWrite", EditConditionHides))
 	float DepthWriteBias = 50.0f;
 
+	/** Hole texture storage format. Compact formats cut hole VRAM and atlas copy bandwidth by 4-8x. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering")
+	EIVSmokeHoleTextureFormat HoleTextureFormat = EIVSmokeHoleTextureFormat::Full;
+
+	/**
+	 * Voxel data path. Time Atlas removes the per-frame density and FXAA passes at the cost of 8 texel loads per density sample.
+	 * Without the voxel FXAA, Time Atlas shows harder stair-stepped edges on the smoke silhouette than Density Atlas.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering")
+	EIVSmokeVoxelDataMode VoxelDataMode = EIVSmokeVoxelDataMode::DensityAtlas;
+
+	/** Skip volumes whose active smoke bounds are outside every view frustum. Culled volumes are not packed, uploaded or tiled. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering")
+	bool bEnableFrustumCulling = true;
+
+	/** Distance in centimeters the smoke bounds are grown by before the frustum test, covers edge noise and off-screen smoke shadowing visible smoke. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "0.0", ClampMax = "5000.0", EditCondition = "bShowAdvancedOptions && bEnableFrustumCulling", EditConditionHides))
+	float FrustumCullingMargin = 200.0f;
+
+	/**
+	 * Accumulate the half resolution ray march over frames. Rays are jittered every frame, last frame's smoke is
+	 * reprojected through the first hit positions and blended in after a neighborhood clamp.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering")
+	bool bEnableTemporalAccumulation = false;
+
+	/** Step reduction while accumulating: MaxSteps is divided and MinStepSize multiplied by this. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "1.0", ClampMax = "4.0", EditCondition = "bEnableTemporalAccumulation", EditConditionHides))
+	float TemporalStepReduction = 2.0f;
+
+	/** Weight of the reprojected history. Higher is smoother but reacts slower to changes. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "0.0", ClampMax = "0.98", EditCondition = "bShowAdvancedOptions && bEnableTemporalAccumulation", EditConditionHides))
+	float TemporalHistoryWeight = 0.9f;
+
+	/**
+	 * Scale the ray march resolution to hold the smoke pre-pass of each view within a GPU time budget.
+	 * The pre-pass is timed on the GPU and the scale follows a few frames behind. Off = fixed half resolution.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering")
+	bool bEnableDynamicResolution = false;
+
+	/**
+	 * GPU time budget of the smoke pre-pass (ray march, upscale, filter, depth write) per view in milliseconds.
+	 * Every view (split screen, editor viewports) keeps its own resolution scale measured against this budget.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "0.1", ClampMax = "16.0", EditCondition = "bEnableDynamicResolution", EditConditionHides))
+	float DynamicResolutionBudgetMs = 2.0f;
+
+	/** Lowest ray march resolution scale per axis. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "0.25", ClampMax = "1.0", EditCondition = "bShowAdvancedOptions && bEnableDynamicResolution", EditConditionHides))
+	float MinDynamicResolutionScale = 0.25f;
+
+	/** Highest ray march resolution scale per axis. */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "IVSmoke | Rendering",
+		meta = (ClampMin = "0.25", ClampMax = "1.0", EditCondition = "bShowAdvancedOptions && bEnableDynamicResolution", EditConditionHides))
+	float MaxDynamicResolutionScale = 1.0f;
+
 	//~==============================================================================
 	// Debug
 
@@ -10,6 +10,7 @@
 #include "SceneTexturesConfig.h"
 #include "SceneView.h"
 #include "ShaderParameterStruct.h"
+#include "IVSmokeVoxelAtlas.h"
 
 //~==============================================================================
 // GPU Data Structures for Multi-Volume Rendering
@@ -51,7 +52,20 @@ struct FIVSmokeVolumeGPUData
 	FVector3f VoxelWorldAABBMax;	// 12 bytes
 	float FadeOutDuration;			// 4 bytes
 
-	float Reserved[4];              // 16 bytes (future use / alignment)
+	/** Texel offset of this volume's GridResolution-sized region in the persistent voxel atlas. */
+	FIntVector3 VoxelAtlasOffset;	// 12 bytes
+	/** Slot in the persistent voxel atlas. VoxelBufferOffset points at the same slot in the birth/death buffers. */
+	int32 VoxelAtlasSlot;			// 4 bytes
+
+	/** Max distortion encoded in the compact hole distortion texture (0 = none). */
+	float HoleDistortionRange;		// 4 bytes
+
+	/** Slot in the persistent hole atlas (INDEX_NONE = no holes). */
+	int32 HoleAtlasSlot;			// 4 bytes
+
+	/** Fraction of the full ray march sample rate this volume gets from the significance pass (1 = full quality). */
+	float StepQuality;				// 4 bytes
+	float Reserved;                 // 4 bytes (future use / alignment)
 };
 
 // Ensure structure is 256 bytes for efficient GPU access
@@ -115,14 +129,10 @@ public:
 		/** Per-volume GPU metadata (transform, bounds, etc.). */
 		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FIVSmokeVolumeGPUData>, VolumeDataBuffer)
 
-		/** Total atlas texture size. */
-		SHADER_PARAMETER(FIntVector, TexSize)
-		/** Voxel resolution per volume. */
+		/** Largest grid resolution among the volumes. Each volume gets a thread block of VoxelResolution + 2 * PackedInterval. */
 		SHADER_PARAMETER(FIntVector, VoxelResolution)
-		/** Spacing between volumes in atlas. */
+		/** Padding around every region in the atlas, cleared every frame. */
 		SHADER_PARAMETER(int32, PackedInterval)
-		/** Number of volumes per axis in atlas (3D grid layout). */
-		SHADER_PARAMETER(FIntVector, VoxelAtlasCount)
 		/** Current game time for fade animation calculation. */
 		SHADER_PARAMETER(float, GameTime)
 		/** Number of active volumes (for bounds checking). */
@@ -164,6 +174,92 @@ public:
 	END_SHADER_PARAMETER_STRUCT()
 };
 
+class IVSMOKE_API FIVSmokeMacroCellBuildCS : public FGlobalShader
+{
+public:
+	static constexpr uint32 ThreadGroupSizeX = 4;
+	static constexpr uint32 ThreadGroupSizeY = 4;
+	static constexpr uint32 ThreadGroupSizeZ = 4;
+	static constexpr const TCHAR* EventName = TEXT("IVSmokeMacroCellBuildCS");
+
+	DECLARE_GLOBAL_SHADER(FIVSmokeMacroCellBuildCS);
+	SHADER_USE_PARAMETER_STRUCT(FIVSmokeMacroCellBuildCS, FGlobalShader);
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		/** Output max density per macro cell, covering the voxel atlas at 1/MacroCellSize resolution. */
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture3D<float>, Desti)
+		/** Density atlas the ray march samples (after voxel FXAA). */
+		SHADER_PARAMETER_RDG_TEXTURE_SRV(Texture3D<float>, Source)
+		/** Per-volume GPU metadata (grid resolution, atlas offset). */
+		SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<FIVSmokeVolumeGPUData>, VolumeDataBuffer)
+
+		/** Macro cells of the largest volume. Each volume gets a thread block of this size. */
+		SHADER_PARAMETER(FIntVector, MacroCellCount)
+		/** Number of active volumes (for bounds checking). */
+		SHADER_PARAMETER(int32, VolumeCount)
+	END_SHADER_PARAMETER_STRUCT()
+
+public:
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+
+	static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+	{
+		FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+		OutEnvironment.SetDefine(TEXT("MACRO_CELL_SIZE"), FIVSmokeVoxelAtlas::MacroCellSize);
+	}
+};
+
+class IVSMOKE_API FIVSmokeTemporalAccumulateCS : public FGlobalShader
+{
+public:
+	static constexpr uint32 ThreadGroupSizeX = 8;
+	static constexpr uint32 ThreadGroupSizeY = 8;
+	static constexpr uint32 ThreadGroupSizeZ = 1;
+	static constexpr const TCHAR* EventName = TEXT("IVSmokeTemporalAccumulateCS");
+
+	/** Changed volumes tested individually, matches MAX_CHANGED_VOLUMES and the parameter arrays. More scale history everywhere. */
+	static constexpr int32 MaxChangedVolumes = 16;
+
+	DECLARE_GLOBAL_SHADER(FIVSmokeTemporalAccumulateCS);
+	SHADER_USE_PARAMETER_STRUCT(FIVSmokeTemporalAccumulateCS, FGlobalShader);
+	BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+		/** Accumulated smoke albedo, kept as next frame's history. */
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutAlbedo)
+		/** Accumulated local position and alpha, kept as next frame's history. */
+		SHADER_PARAMETER_RDG_TEXTURE_UAV(RWTexture2D<float4>, OutLocalPosAlpha)
+		/** Current frame ray march outputs. */
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, CurrentAlbedo)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, CurrentLocalPosAlpha)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, CurrentWorldPosDepth)
+		/** Last frame's accumulated outputs of the same view. */
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, HistoryAlbedo)
+		SHADER_PARAMETER_RDG_TEXTURE(Texture2D<float4>, HistoryLocalPosAlpha)
+		/** Linear sampler with clamp addressing. */
+		SHADER_PARAMETER_SAMPLER(SamplerState, LinearClamp_Sampler)
+		/** Last frame's world to clip transform, relative to PrevViewOrigin (no TAA jitter). */
+		SHADER_PARAMETER(FMatrix44f, PrevTranslatedWorldToClip)
+		SHADER_PARAMETER(FVector3f, PrevViewOrigin)
+		/** Size of the half resolution textures. */
+		SHADER_PARAMETER(FIntPoint, TexSize)
+		/** Weight of the reprojected history, 0 = current frame only. */
+		SHADER_PARAMETER(float, HistoryWeight)
+		/** History weight scale inside volumes whose voxel data changed this frame. */
+		SHADER_PARAMETER(float, ChangedHistoryScale)
+		/** Number of changed volume bounds, -1 when there are more than MaxChangedVolumes. */
+		SHADER_PARAMETER(int32, NumChangedVolumes)
+		SHADER_PARAMETER_ARRAY(FVector4f, ChangedVolumeMin, [16])
+		SHADER_PARAMETER_ARRAY(FVector4f, ChangedVolumeMax, [16])
+	END_SHADER_PARAMETER_STRUCT()
+
+public:
+	static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+	{
+		return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+	}
+};
+
 class IVSMOKE_API FIVSmokeCompositePS : public FGlobalShader
 {
 public:
@@ -251,6 +347,8 @@ public:
 		SHADER_PARAMETER(FVector2f, ViewportSize)
 		/** View rect offset for multi-view support. */
 		SHADER_PARAMETER(FVector2f, ViewRectMin)
+		/** Full resolution over ray march resolution, the size of one ray march texel in output texels. */
+		SHADER_PARAMETER(FVector2f, UpsampleRatio)
 		RENDER_TARGET_BINDING_SLOTS()
 	END_SHADER_PARAMETER_STRUCT()
 
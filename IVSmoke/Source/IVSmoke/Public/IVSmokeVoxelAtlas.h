@@ -0,0 +1,216 @@
+// Copyright (c) 2026, Team SDB. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderGraphResources.h"
+
+class FRDGBuilder;
+
+/**
+ * @struct FIVSmokeVoxelAtlasLayout
+ * @brief Size of the persistent voxel atlas resources.
+ *        The density (or time) atlas is a grid of BrickSize^3 bricks, the birth and death time buffers are linear.
+ */
+struct IVSMOKE_API FIVSmokeVoxelAtlasLayout
+{
+	/** Number of bricks per axis. Zero until the first slot is allocated. */
+	FIntVector BrickCount = FIntVector::ZeroValue;
+
+	/** Number of voxels the birth and death time buffers hold. */
+	int32 BufferCapacity = 0;
+
+	/** Birth/death times go straight into the RG32F time atlas instead of the buffers (EIVSmokeVoxelDataMode::TimeAtlas). */
+	bool bTimeAtlas = false;
+
+	bool IsValid() const { return BrickCount.X > 0 && BrickCount.Y > 0 && BrickCount.Z > 0 && BufferCapacity > 0; }
+
+	/** Full atlas texture resolution. */
+	FIntVector GetAtlasResolution() const;
+
+	/** Resolution of the macro cell grid covering the atlas. */
+	FIntVector GetMacroCellResolution() const;
+
+	bool operator==(const FIVSmokeVoxelAtlasLayout& Other) const
+	{
+		return BrickCount == Other.BrickCount && BufferCapacity == Other.BufferCapacity && bTimeAtlas == Other.bTimeAtlas;
+	}
+	bool operator!=(const FIVSmokeVoxelAtlasLayout& Other) const { return !(*this == Other); }
+};
+
+/**
+ * @struct FIVSmokeVoxelAtlasRegion
+ * @brief Where a slot lives in the atlas. Each slot reserves a box of bricks fitting its own resolution
+ *        plus SlotInterval voxels of padding on every side, and a contiguous range of the voxel buffers.
+ */
+struct IVSMOKE_API FIVSmokeVoxelAtlasRegion
+{
+	/** Resolution of the slot's voxel grid. Zero when the slot is free. */
+	FIntVector Resolution = FIntVector::ZeroValue;
+
+	/** Texel offset of the first grid voxel inside the atlas (padding excluded). */
+	FIntVector AtlasOffset = FIntVector::ZeroValue;
+
+	/** First brick and brick count of the reserved box (padding included). */
+	FIntVector BrickMin = FIntVector::ZeroValue;
+	FIntVector BrickExtent = FIntVector::ZeroValue;
+
+	/** Offset of the slot's voxels in the birth and death time buffers. */
+	int32 BufferOffset = 0;
+
+	bool IsValid() const { return Resolution.X > 0 && Resolution.Y > 0 && Resolution.Z > 0; }
+	int32 GetVoxelCount() const { return Resolution.X * Resolution.Y * Resolution.Z; }
+};
+
+/**
+ * @class FIVSmokeVoxelAtlas
+ * @brief Persistent voxel birth/death buffers and density atlas with a stable slot per rendered volume.
+ *        Slots are sized to their own volume: the atlas packs brick boxes first-fit and grows (re-packing
+ *        every slot) when full, the buffers hand out first-fit voxel ranges and double when full.
+ *        Slots are allocated and freed on the game thread by the renderer, which uploads a slot only
+ *        when its volume's voxel data is dirty. Uploads are queued for the render thread and copied into
+ *        the persistent buffers the next time they are registered.
+ *        The density atlas is still evaluated every frame, since fade in/out depend on the game time,
+ *        so re-packing the atlas keeps uploaded data. Grown buffers copy their old contents on the GPU.
+ *        In time atlas mode uploads skip the buffers and update the slot's brick box of a persistent
+ *        birth/death time texture instead, which the ray march evaluates per sample. Re-packing then
+ *        requires every slot to be uploaded again.
+ *        Uploads to the time atlas also write the slot's macro cells (earliest birth, latest death of each
+ *        MacroCellSize^3 block and its neighbors), which the ray march uses to leap over empty space.
+ */
+class IVSMOKE_API FIVSmokeVoxelAtlas
+{
+public:
+	static FIVSmokeVoxelAtlas& Get();
+
+	/** Padding around every slot, matches the hole atlas packing. */
+	static constexpr int32 SlotInterval = 4;
+
+	/** Allocation granularity of the density atlas. */
+	static constexpr int32 BrickSize = 8;
+
+	/** Voxels per axis of an empty space skipping macro cell. Divides BrickSize and SlotInterval, so cells line up with every slot's grid. */
+	static constexpr int32 MacroCellSize = 4;
+
+	/** Maximum atlas size per axis. */
+	static constexpr int32 MaxAtlasSize = 2048;
+
+	/** Initial number of bricks per axis. The smallest axis doubles when the atlas is full. */
+	static constexpr int32 MinBrickCount = 8;
+
+	/** Initial voxel buffer capacity. Capacity doubles when exhausted. */
+	static constexpr int32 MinBufferCapacity = 64 * 64 * 64;
+
+	//~============================================================================
+	// Game Thread
+#pragma region Game Thread
+public:
+	/**
+	 * Allocate a slot fitting Resolution. The atlas is re-packed into more bricks when no free box is large
+	 * enough and the buffers grow when no free range is. Slot indices stay valid across both, and so does uploaded
+	 * data unless the time atlas is re-packed. Only the atlas offsets of the slots move (see GetRegion).
+	 * @return Slot index, or INDEX_NONE if the atlas is full. Failures are logged Verbose, callers retrying every frame warn once.
+	 */
+	int32 AllocateSlot(const FIntVector& Resolution);
+
+	/** Free a slot and drop its queued upload. Its bricks and voxel range are reused by later allocations. */
+	void FreeSlot(const int32 Slot);
+
+	/** Where Slot lives in the atlas and buffers. Invalid region for free or unknown slots. */
+	FIVSmokeVoxelAtlasRegion GetRegion(const int32 Slot) const { return Regions.IsValidIndex(Slot) ? Regions[Slot] : FIVSmokeVoxelAtlasRegion(); }
+
+	/** Whether Slot holds uploaded data since it was allocated or the atlas was released. */
+	bool IsSlotUploaded(const int32 Slot) const { return UploadedSlots.IsValidIndex(Slot) && UploadedSlots[Slot]; }
+
+	/** Queue a volume's birth and death times for upload into Slot. The arrays are moved into the render command. */
+	void UploadSlot(const int32 Slot, TArray<float> BirthTimes, TArray<float> DeathTimes);
+
+	/** Switch between the density and time atlas paths. Every slot must be uploaded again after a switch. */
+	void SetTimeAtlas(const bool bTimeAtlas);
+
+	/** Layout as seen by the game thread. */
+	const FIVSmokeVoxelAtlasLayout& GetLayout() const { return Layout; }
+
+	/** Release all GPU resources on the render thread. Every slot is uploaded again on next use. */
+	void Release();
+#pragma endregion
+
+	//~============================================================================
+	// Render Thread
+#pragma region Render Thread
+public:
+	/** Layout the render thread resources are built with. */
+	const FIVSmokeVoxelAtlasLayout& GetLayout_RenderThread() const { return RenderLayout; }
+
+	/**
+	 * Register the birth and death time buffers, creating them if needed, and copy pending uploads into them.
+	 * @return false when no slot was ever allocated.
+	 */
+	bool RegisterBuffers(FRDGBuilder& GraphBuilder, FRDGBufferRef& OutBirthTimes, FRDGBufferRef& OutDeathTimes);
+
+	/** Register the density atlas, creating it cleared to zero (padding stays empty). nullptr when no slot was ever allocated. */
+	FRDGTextureRef RegisterDensityAtlas(FRDGBuilder& GraphBuilder);
+
+	/**
+	 * Register the time atlas and its RG32F macro cell atlas, creating them cleared to empty, and write pending uploads
+	 * into both with texture region updates.
+	 * @return nullptr when no slot was ever allocated or the time atlas is not in use.
+	 */
+	FRDGTextureRef RegisterTimeAtlas(FRDGBuilder& GraphBuilder, FRDGTextureRef& OutMacroCellAtlas);
+
+	/** GPU memory of the allocated buffers and atlas. */
+	int64 GetMemorySize_RenderThread() const;
+#pragma endregion
+
+private:
+	FIVSmokeVoxelAtlas() = default;
+
+	/**
+	 * Re-pack every allocated slot, largest first, into an atlas of BrickCount bricks (first-fit over BrickOccupancy).
+	 * @return false if they do not fit, in which case nothing is changed.
+	 */
+	bool RepackBricks(const FIntVector& BrickCount);
+
+	/** Allocate a first-fit range of the voxel buffers, growing InOutBufferCapacity if the range is appended. */
+	int32 AllocateBufferRange(const int32 Count, int32& InOutBufferCapacity);
+
+	/** Return a range of the voxel buffers, merging it with adjacent free ranges and the buffer end. */
+	void FreeBufferRange(const int32 Offset, const int32 Count);
+
+	/** Apply a new game thread layout and forward it to the render thread. */
+	void Relayout(const FIVSmokeVoxelAtlasLayout& NewLayout);
+
+	/** Voxel data waiting to be copied into a slot on the render thread. */
+	struct FPendingUpload
+	{
+		int32 Slot = INDEX_NONE;
+		FIVSmokeVoxelAtlasRegion Region;
+		TArray<float> BirthTimes;
+		TArray<float> DeathTimes;
+	};
+
+	/** Unused range of the voxel buffers. */
+	struct FBufferRange
+	{
+		int32 Offset = 0;
+		int32 Count = 0;
+	};
+
+	//~ Game thread state
+	FIVSmokeVoxelAtlasLayout Layout;
+	TArray<FIVSmokeVoxelAtlasRegion> Regions;
+	TArray<int32> FreeSlots;
+	TBitArray<> BrickOccupancy;
+	TArray<FBufferRange> FreeBufferRanges;
+	int32 BufferEnd = 0;
+	TBitArray<> UploadedSlots;
+
+	//~ Render thread state
+	FIVSmokeVoxelAtlasLayout RenderLayout;
+	TArray<FPendingUpload> PendingUploads;
+	TRefCountPtr<FRDGPooledBuffer> BirthTimesBuffer;
+	TRefCountPtr<FRDGPooledBuffer> DeathTimesBuffer;
+	TRefCountPtr<IPooledRenderTarget> DensityAtlas;
+	TRefCountPtr<IPooledRenderTarget> TimeAtlas;
+	TRefCountPtr<IPooledRenderTarget> TimeMacroCellAtlas;
+};
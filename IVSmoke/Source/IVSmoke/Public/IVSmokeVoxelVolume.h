@@ -697,8 +697,19 @@ public:
 		return UIVSmokeGridLibrary::IsVoxelBitSet(VoxelBits, GridPos, GetGridResolution());
 	}
 
-	/** Returns the RHI texture resource from the HoleGeneratorComponent, if available. */
-	FTextureRHIRef GetHoleTexture() const;
+	/**
+	 * Finds the span of a world-space ray that passes through active voxels.
+	 * The ray is clipped by a slab test against the current voxel AABB, then refined by a 3D DDA over `VoxelBits`
+	 * from the first to the last active voxel it crosses. Gaps between active voxels are included in the span.
+	 * The span is padded by one voxel on both ends (within the voxel AABB), trilinear density reaches that far.
+	 *
+	 * @param Origin				World-space ray origin.
+	 * @param Direction				World-space ray direction.
+	 * @param OutEntryDistance		Distance along the normalized direction where the ray enters smoke.
+	 * @param OutExitDistance		Distance along the normalized direction where the ray leaves smoke.
+	 * @return						True if the ray crosses any active voxel.
+	 */
+	bool TraceActiveVoxelSpan(const FVector& Origin, const FVector& Direction, double& OutEntryDistance, double& OutExitDistance) const;
 
 	/**
 	 * Returns the synchronized world time in seconds.